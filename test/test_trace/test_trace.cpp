@@ -0,0 +1,92 @@
+/*
+ * Unit test for the event tracer ring buffer and Chrome trace writer (wled00/trace.h)
+ * Runs on the host: pio test -e native
+ */
+#include <string>
+#include <vector>
+#include <unity.h>
+#include "trace.h"
+
+#define CHECK(cond) TEST_ASSERT_TRUE(cond)
+
+struct StringOut {
+  std::string s;
+  void print(const char *str) { s += str; }
+};
+
+static const char *nameOf(uint8_t name) { return name == 0 ? "outer" : "inner"; }
+static const char *tidName(unsigned tid) { return tid < 2 ? (tid ? "async" : "loop") : nullptr; }
+
+// counts occurrences of needle
+static unsigned count(const std::string &s, const char *needle) {
+  unsigned n = 0;
+  for (size_t pos = s.find(needle); pos != std::string::npos; pos = s.find(needle, pos + 1)) n++;
+  return n;
+}
+
+// checks that B/E events of each tid are properly nested in the exported events
+static bool balanced(const std::string &s) {
+  int depth[TRACE_MAX_TIDS] = {0};
+  for (size_t pos = s.find("\"ph\":\""); pos != std::string::npos; pos = s.find("\"ph\":\"", pos + 1)) {
+    char ph = s[pos + 6];
+    size_t t = s.find("\"tid\":", pos);
+    unsigned tid = atoi(s.c_str() + t + 6);
+    if (tid >= TRACE_MAX_TIDS) return false;
+    if (ph == TRACE_PH_BEGIN) depth[tid]++;
+    if (ph == TRACE_PH_END && --depth[tid] < 0) return false;
+  }
+  return true;
+}
+
+static void testWraparound() {
+  trace_event_t storage[8];
+  TraceRing ring(storage, 8);
+  for (uint32_t i = 0; i < 21; i++) ring.add(1000 + i, 0, TRACE_PH_INSTANT, 0, i);
+  CHECK(ring.count() == 8);
+  CHECK(ring.get(0).arg == 13); // oldest kept event
+  CHECK(ring.get(7).arg == 20);
+  trace_event_t copy[4];
+  CHECK(ring.copy(copy, 4) == 4);
+  CHECK(copy[0].arg == 17 && copy[3].arg == 20); // newest events, oldest first
+  ring.clear();
+  CHECK(ring.count() == 0);
+}
+
+static void testBalancedExport() {
+  trace_event_t storage[16];
+  TraceRing ring(storage, 16);
+  uint32_t ts = 0;
+  // nested pairs on two tracks, more than fit so the ring wraps in the middle of a pair
+  for (unsigned i = 0; i < 7; i++) {
+    const uint8_t tid = i & 1;
+    ring.add(ts++, 0, TRACE_PH_BEGIN, tid, i);
+    ring.add(ts++, 1, TRACE_PH_BEGIN, tid, i);
+    ring.add(ts++, 1, TRACE_PH_END,   tid, i);
+    ring.add(ts++, 0, TRACE_PH_END,   tid, i);
+  }
+  ring.add(ts++, 0, TRACE_PH_INSTANT, 1, 0);
+  std::vector<trace_event_t> events(16);
+  size_t n = ring.copy(events.data(), events.size());
+  CHECK(n == 16);
+  CHECK(events[0].phase == TRACE_PH_BEGIN && events[0].name == 1); // outer begin of the oldest pair was overwritten
+
+  StringOut out;
+  writeChromeTrace(out, events.data(), n, nameOf, tidName);
+  CHECK(out.s.rfind("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", 0) == 0);
+  CHECK(out.s.compare(out.s.size() - 2, 2, "]}") == 0);
+  CHECK(count(out.s, "\"thread_name\"") == 2); // unused tracks are not named
+  CHECK(count(out.s, "\"ph\":\"B\"") == count(out.s, "\"ph\":\"E\""));
+  CHECK(count(out.s, "\"ph\":\"i\"") == 1);
+  CHECK(balanced(out.s));
+  CHECK(out.s.find("\"ts\":0,") != std::string::npos); // timestamps relative to oldest event
+}
+
+void setUp() {}
+void tearDown() {}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(testWraparound);
+  RUN_TEST(testBalancedExport);
+  return UNITY_END();
+}
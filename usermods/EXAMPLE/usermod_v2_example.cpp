@@ -110,6 +110,10 @@ class MyExampleUsermod : public Usermod {
      * 
      * 2. Try to avoid using the delay() function. NEVER use delays longer than 10 milliseconds.
      *    Instead, use a timer check as shown here.
+     *
+     * 3. Periodic work that takes a while (i.e. reading an I2C sensor) is better registered as a background job in setup():
+     *      addJob([](void *um){ static_cast<MyExampleUsermod*>(um)->readSensor(); }, this, 5000, 2000, 1000, PSTR("example"));
+     *    runs readSensor() every 5s in the time left between frames (budget 2ms, delayed by at most 1s), see wled00/sched.cpp
      */
     void loop() override {
       // if usermod is disabled or called during strip updating just exit
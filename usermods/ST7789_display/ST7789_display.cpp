@@ -35,6 +35,13 @@
 #define USERMOD_ID_ST7789_DISPLAY 97
 
 TFT_eSPI tft = TFT_eSPI(TFT_WIDTH, TFT_HEIGHT); // Invoke custom library
+TFT_eSprite screen = TFT_eSprite(&tft);         // off-screen frame, only changed tiles are sent to the display
+
+// called by the display service (from its task on ESP32, in the frame slack on ESP8266)
+static void flushScreen(void *arg, uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+{
+    screen.pushSprite(x, y, x, y, w, h);
+}
 
 // Extra char (+1) for null
 #define LINE_BUFFER_SIZE          20
@@ -52,6 +59,9 @@ class St7789DisplayUsermod : public Usermod {
     unsigned long lastTime = 0;
     bool enabled = true;
 
+    DisplayFramebuffer display = DisplayFramebuffer(flushScreen);
+    TFT_eSPI *gfx = &tft; // screen if the off-screen frame could be allocated
+
     bool displayTurnedOff = false;
     long lastRedraw = 0;
     // needRedraw marks if redraw is required to prevent often redrawing.
@@ -94,10 +104,10 @@ class St7789DisplayUsermod : public Usermod {
 
         byte currentMonth = month(localTime);
         sprintf_P(lineBuffer, PSTR("%s %2d "), monthShortStr(currentMonth), day(localTime));
-        tft.setTextColor(TFT_SILVER);
-        tft.setCursor(84, 0);
-        tft.setTextSize(2);
-        tft.print(lineBuffer);
+        gfx->setTextColor(TFT_SILVER);
+        gfx->setCursor(84, 0);
+        gfx->setTextSize(2);
+        gfx->print(lineBuffer);
 
         byte showHour = hourCurrent;
         boolean isAM = false;
@@ -114,16 +124,16 @@ class St7789DisplayUsermod : public Usermod {
         }
 
         sprintf_P(lineBuffer, PSTR("%2d:%02d"), (useAMPM ? showHour : hourCurrent), minuteCurrent);
-        tft.setTextColor(TFT_WHITE);
-        tft.setTextSize(4);
-        tft.setCursor(60, 24);
-        tft.print(lineBuffer);
+        gfx->setTextColor(TFT_WHITE);
+        gfx->setTextSize(4);
+        gfx->setCursor(60, 24);
+        gfx->print(lineBuffer);
 
-        tft.setTextSize(2);
-        tft.setCursor(186, 24);
+        gfx->setTextSize(2);
+        gfx->setCursor(186, 24);
         //sprintf_P(lineBuffer, PSTR("%02d"), secondCurrent);
-        if (useAMPM) tft.print(isAM ? "AM" : "PM");
-        //else         tft.print(lineBuffer);
+        if (useAMPM) gfx->print(isAM ? "AM" : "PM");
+        //else         gfx->print(lineBuffer);
     }
 
   public:
@@ -157,6 +167,21 @@ class St7789DisplayUsermod : public Usermod {
             pinMode(TFT_BL, OUTPUT); // Set backlight pin to output mode
             digitalWrite(TFT_BL, HIGH); // Turn backlight on.
         }
+
+        // draw into an off-screen frame if there is enough memory (240x240: 115kB at 16 bit, 57kB at 8 bit)
+        #ifdef ARDUINO_ARCH_ESP32
+        const uint8_t depth = psramFound() ? 16 : 8;
+        #else
+        const uint8_t depth = 8;
+        #endif
+        screen.setColorDepth(depth);
+        if (screen.createSprite(tft.width(), tft.height()) &&
+            display.begin(static_cast<const uint8_t*>(screen.getPointer()), tft.width(), tft.height(), depth/8)) {
+            gfx = &screen;
+        } else {
+            screen.deleteSprite(); // not enough memory, draw directly
+            DEBUG_PRINTLN(F("ST7789: drawing directly."));
+        }
     }
 
     /*
@@ -180,8 +205,8 @@ class St7789DisplayUsermod : public Usermod {
     void loop() override {
         char buff[LINE_BUFFER_SIZE];
 
-        // Check if we time interval for redrawing passes.
-        if (millis() - lastUpdate < USER_LOOP_REFRESH_RATE_MS)
+        // Check if we time interval for redrawing passes (and the last frame has been sent).
+        if (millis() - lastUpdate < USER_LOOP_REFRESH_RATE_MS || display.busy())
         {
             return;
         }
@@ -232,84 +257,86 @@ class St7789DisplayUsermod : public Usermod {
         knownEffectSpeed = strip.getMainSegment().speed;
         knownEffectIntensity = strip.getMainSegment().intensity;
 
-        tft.fillScreen(TFT_BLACK);
+        gfx->fillScreen(TFT_BLACK);
 
         showTime();
 
-        tft.setTextSize(2);
+        gfx->setTextSize(2);
 
         // Wifi name
-        tft.setTextColor(TFT_GREEN);
-        tft.setCursor(0, 60);
+        gfx->setTextColor(TFT_GREEN);
+        gfx->setCursor(0, 60);
         String line = knownSsid.substring(0, tftcharwidth-1);
         // Print `~` char to indicate that SSID is longer, than our display
         if (knownSsid.length() > tftcharwidth) line = line.substring(0, tftcharwidth-1) + '~';
         center(line, tftcharwidth);
-        tft.print(line.c_str());
+        gfx->print(line.c_str());
 
         // Print AP IP and password in AP mode or knownIP if AP not active.
         if (apActive)
         {
-            tft.setCursor(0, 84);
-            tft.print("AP IP: ");
-            tft.print(knownIp);
-            tft.setCursor(0,108);
-            tft.print("AP Pass:");
-            tft.print(apPass);
+            gfx->setCursor(0, 84);
+            gfx->print("AP IP: ");
+            gfx->print(knownIp);
+            gfx->setCursor(0,108);
+            gfx->print("AP Pass:");
+            gfx->print(apPass);
         }
         else
         {
-            tft.setCursor(0, 84);
+            gfx->setCursor(0, 84);
             line = knownIp.toString();
             center(line, tftcharwidth);
-            tft.print(line.c_str());
+            gfx->print(line.c_str());
             // percent brightness
-            tft.setCursor(0, 120);
-            tft.setTextColor(TFT_WHITE);
-            tft.print("Bri: ");
-            tft.print((((int)bri*100)/255));
-            tft.print("%");
+            gfx->setCursor(0, 120);
+            gfx->setTextColor(TFT_WHITE);
+            gfx->print("Bri: ");
+            gfx->print((((int)bri*100)/255));
+            gfx->print("%");
             // signal quality
-            tft.setCursor(124,120);
-            tft.print("Sig: ");
+            gfx->setCursor(124,120);
+            gfx->print("Sig: ");
             if (getSignalQuality(WiFi.RSSI()) < 10) {
-                tft.setTextColor(TFT_RED);
+                gfx->setTextColor(TFT_RED);
             } else if (getSignalQuality(WiFi.RSSI()) < 25) {
-                tft.setTextColor(TFT_ORANGE);
+                gfx->setTextColor(TFT_ORANGE);
             } else {
-                tft.setTextColor(TFT_GREEN);
+                gfx->setTextColor(TFT_GREEN);
             }
-            tft.print(getSignalQuality(WiFi.RSSI()));
-            tft.setTextColor(TFT_WHITE);
-            tft.print("%");
+            gfx->print(getSignalQuality(WiFi.RSSI()));
+            gfx->setTextColor(TFT_WHITE);
+            gfx->print("%");
         }
 
         // mode name
-        tft.setTextColor(TFT_CYAN);
-        tft.setCursor(0, 144);
+        gfx->setTextColor(TFT_CYAN);
+        gfx->setCursor(0, 144);
         char lineBuffer[tftcharwidth+1];
         extractModeName(knownMode, JSON_mode_names, lineBuffer, tftcharwidth);
-        tft.print(lineBuffer);
+        gfx->print(lineBuffer);
 
         // palette name
-        tft.setTextColor(TFT_YELLOW);
-        tft.setCursor(0, 168);
+        gfx->setTextColor(TFT_YELLOW);
+        gfx->setCursor(0, 168);
         extractModeName(knownPalette, JSON_palette_names, lineBuffer, tftcharwidth);
-        tft.print(lineBuffer);
+        gfx->print(lineBuffer);
 
-        tft.setCursor(0, 192);
-        tft.setTextColor(TFT_SILVER);
+        gfx->setCursor(0, 192);
+        gfx->setTextColor(TFT_SILVER);
         sprintf_P(buff, PSTR("FX  Spd:%3d Int:%3d"), effectSpeed, effectIntensity);
-        tft.print(buff);
+        gfx->print(buff);
 
         // Fifth row with estimated mA usage
-        tft.setTextColor(TFT_SILVER);
-        tft.setCursor(0, 216);
+        gfx->setTextColor(TFT_SILVER);
+        gfx->setCursor(0, 216);
         // Print estimated milliamp usage (must specify the LED type in LED prefs for this to be a reasonable estimate).
-        tft.print("Current: ");
-        tft.setTextColor(TFT_ORANGE);
-        tft.print(BusManager::currentMilliamps());
-        tft.print("mA");
+        gfx->print("Current: ");
+        gfx->setTextColor(TFT_ORANGE);
+        gfx->print(BusManager::currentMilliamps());
+        gfx->print("mA");
+
+        if (gfx == &screen) display.commit();
     }
 
     /*
@@ -410,5 +437,5 @@ class St7789DisplayUsermod : public Usermod {
    //Your usermod will remain compatible as it does not need to implement all methods from the Usermod base class!
 };
 
-static name. st7789_display;
+static St7789DisplayUsermod st7789_display;
 REGISTER_USERMOD(st7789_display);
\ No newline at end of file
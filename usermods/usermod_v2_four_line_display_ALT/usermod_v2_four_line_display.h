@@ -43,6 +43,14 @@
 // Minimum time between redrawing screen in ms
 #define REFRESH_RATE_MS 1000
 
+// Without the display task the redraw runs as a background job (sched.cpp) in the time left until the next LED frame
+#ifndef FLD_JOB_BUDGET_US
+  #define FLD_JOB_BUDGET_US 10000   // time a redraw may take (a full redraw of a 128x64 I2C display takes longer)
+#endif
+#ifndef FLD_JOB_MAX_DELAY
+  #define FLD_JOB_MAX_DELAY 1000    // ms a redraw may wait for enough slack before it is done anyway
+#endif
+
 // Extra char (+1) for null
 #define LINE_BUFFER_SIZE            16+1
 #define MAX_JSON_CHARS              19+1
@@ -118,6 +126,10 @@ class FourLineDisplayUsermod : public Usermod {
   
       bool displayTurnedOff = false;
       unsigned long nextUpdate = 0;
+      #if !(defined(ARDUINO_ARCH_ESP32) && defined(FLD_ESP32_USE_THREADS))
+      int redrawJob = -1;
+      bool redrawDue = false;
+      #endif
       unsigned long lastRedraw = 0;
       unsigned long overlayUntil = 0;
   
@@ -257,6 +257,15 @@ void FourLineDisplayUsermod::setup() {
 
   startDisplay();
   onUpdateBegin(false);  // create Display task
+#if !(defined(ARDUINO_ARCH_ESP32) && defined(FLD_ESP32_USE_THREADS))
+  // redraw (I2C/SPI transfer) is done in the frame slack instead of stalling the LED output
+  redrawJob = addJob([](void *um) {
+      auto fld = static_cast<FourLineDisplayUsermod*>(um);
+      if (!fld->redrawDue) return;
+      fld->redrawDue = false;
+      fld->redraw(false);
+    }, this, refreshRate, FLD_JOB_BUDGET_US, FLD_JOB_MAX_DELAY, PSTR("4LD"));
+#endif
   initDone = true;
 }
 
@@ -277,7 +286,9 @@ void FourLineDisplayUsermod::loop() {
   unsigned long now = millis();
   if (now < nextUpdate) return;
   nextUpdate = now + ((displayTurnedOff && clockMode && showSeconds) ? 1000 : refreshRate);
-  redraw(false);
+  redrawDue = true;
+  if (redrawJob >= 0) triggerJob(redrawJob);
+  else                redraw(false); // no free job slot
 #endif
 }
 
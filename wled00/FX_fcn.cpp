@@ -1238,6 +1238,7 @@ void WS2812FX::finalizeInit() {
   }
   BusManager::initializeABL(); // init brightness limiter
   DEBUG_PRINTF_P(PSTR("Heap after buses: %d\n"), ESP.getFreeHeap());
+  bootPhase(BOOT_BUS);
 
   Segment::maxWidth  = _length;
   Segment::maxHeight = 1;
@@ -1245,8 +1246,10 @@ void WS2812FX::finalizeInit() {
   //segments are created in makeAutoSegments();
   DEBUG_PRINTLN(F("Loading custom palettes"));
   loadCustomPalettes(); // (re)load all custom palettes
+  bootPhase(BOOT_PALETTES);
   DEBUG_PRINTLN(F("Loading custom ledmaps"));
   deserializeMap();     // (re)load default ledmap (will also setUpMatrix() if ledmap does not exist)
+  bootPhase(BOOT_LEDMAP);
 
   // allocate frame buffer after matrix has been set up (gaps!)
   p_free(_pixels); // using realloc on large buffers can cause additional fragmentation instead of reducing it
@@ -1266,6 +1269,7 @@ void WS2812FX::service() {
   }
 
   bool doShow = false;
+  TraceScope trace(TRACE_SERVICE);
 
   _isServicing = true;
   _segment_index = 0;
@@ -1287,6 +1291,7 @@ void WS2812FX::service() {
       unsigned frameDelay = FRAMETIME;
 
       if (!seg.freeze) { //only run effect function if not frozen
+        const unsigned long fxStart = micros();
         // Effect blending
         uint16_t prog = seg.progress();
         seg.beginDraw(prog);                // set up parameters for get/setPixelColor() (will also blend colors and palette if blend style is FADE)
@@ -1308,6 +1313,7 @@ void WS2812FX::service() {
           Segment::modeBlend(false);        // unset semaphore
         }
         if (seg.isInTransition() && frameDelay > FRAMETIME) frameDelay = FRAMETIME; // force faster updates during transition
+        perfRecordEffect(_segment_index, fxStart);
       }
 
       seg.next_time = nowUp + frameDelay;
@@ -1593,6 +1599,8 @@ void WS2812FX::blendSegment(const Segment &topSegment) const {
 }
 
 void WS2812FX::show() {
+  PerfScope perf(PERF_SHOW);
+  TraceScope trace(TRACE_SHOW);
   if (!_pixels) {
     DEBUGFX_PRINTLN(F("Error: no _pixels!"));
     errorFlag = ERR_NORAM;
@@ -1647,7 +1655,16 @@ void WS2812FX::show() {
   // some buses send asynchronously and this method will return before
   // all of the data has been sent.
   // See https://github.com/Makuna/NeoPixelBus/wiki/ESP32-NeoMethods#neoesp32rmt-methods
+  const unsigned long busStart = micros();
+  traceEvent(TRACE_BUS_SHOW, TRACE_PH_BEGIN);
   BusManager::show();
+  traceEvent(TRACE_BUS_SHOW, TRACE_PH_END);
+  perfRecord(PERF_BUS_SHOW, busStart);
+  static bool ablTraced = false; // trace periods of ABL limiting brightness
+  if (BusManager::ablLimited() != ablTraced) {
+    ablTraced = !ablTraced;
+    traceEvent(TRACE_ABL, ablTraced ? TRACE_PH_BEGIN : TRACE_PH_END);
+  }
 
   if (diff > 0) { // skip calculation if no time has passed
     size_t fpsCurr = (1000 << FPS_CALC_SHIFT) / diff; // fixed point math
@@ -1665,6 +1682,23 @@ void WS2812FX::setRealtimePixelColor(unsigned i, uint32_t c) {
   }
 }
 
+// unpacks count consecutive RGB (3 bytes) or RGBW (4 bytes) pixels into realtime buffer starting at pixel start
+// destination and its length are resolved once instead of per pixel (used for multi-universe E1.31/Art-Net/DDP)
+void WS2812FX::setRealtimePixels(unsigned start, const uint8_t *data, unsigned count, bool isRGBW) {
+  uint32_t *dest = _pixels;
+  unsigned  len  = getLengthTotal();
+  if (useMainSegmentOnly) {
+    const Segment &seg = getMainSegment();
+    if (!seg.isActive()) return;
+    dest = seg.getPixels();
+    len  = seg.length();
+  }
+  if (!dest || start >= len) return;
+  const unsigned end = std::min(start + count, len);
+  if (isRGBW) for (unsigned i = start; i < end; i++, data += 4) dest[i] = RGBW32(data[0], data[1], data[2], data[3]);
+  else        for (unsigned i = start; i < end; i++, data += 3) dest[i] = RGBW32(data[0], data[1], data[2], 0);
+}
+
 // reset all segments
 void WS2812FX::restartRuntime() {
   suspend();
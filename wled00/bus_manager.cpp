@@ -231,11 +231,12 @@ void BusDigital::estimateCurrent() {
   _milliAmpsTotal = ((uint64_t)_colorSum * actualMilliampsPerLed) / clrUnitsPerChannel + getLength(); // add 1mA standby current per LED to total (WS2812: ~0.7mA, WS2815: ~2mA)
 }
 
-void BusDigital::applyBriLimit(uint8_t newBri) {
+// returns true if brightness was limited
+bool BusDigital::applyBriLimit(uint8_t newBri) {
   // a newBri of 0 means calculate per-bus brightness limit
   _NPBbri = 255; // reset, intermediate value is set below, final value is calculated in bus::show()
   if (newBri == 0) {
-    if (_milliAmpsLimit == 0 || _milliAmpsTotal == 0) return; // ABL not used for this bus
+    if (_milliAmpsLimit == 0 || _milliAmpsTotal == 0) return false; // ABL not used for this bus
     newBri = 255;
 
     if (_milliAmpsLimit > getLength()) { // each LED uses about 1mA in standby
@@ -265,6 +266,7 @@ void BusDigital::applyBriLimit(uint8_t newBri) {
   }
 
   _colorSum = 0; // reset for next frame
+  return newBri < 255;
 }
 
 void BusDigital::show() {
@@ -1393,6 +1395,7 @@ void BusManager::initializeABL() {
 }
 
 void BusManager::applyABL() {
+  _ablLimited = false;
   if (_useABL) {
     unsigned milliAmpsSum = 0; // use temporary variable to always return a valid _gMilliAmpsUsed to UI
     unsigned totalLEDs = 0;
@@ -1401,7 +1404,7 @@ void BusManager::applyABL() {
         BusDigital &busd = static_cast<BusDigital&>(*bus);
         busd.estimateCurrent(); // sets _milliAmpsTotal, current is estimated for all buses even if they have the limit set to 0
         if (_gMilliAmpsMax == 0)
-          busd.applyBriLimit(0); // apply per bus ABL limit, updates _milliAmpsTotal if limit reached
+          _ablLimited |= busd.applyBriLimit(0); // apply per bus ABL limit, updates _milliAmpsTotal if limit reached
         milliAmpsSum += busd.getUsedCurrent();
         totalLEDs += busd.getLength(); // sum total number of LEDs for global Limit
       }
@@ -1425,7 +1428,7 @@ void BusManager::applyABL() {
         if (bus->isDigital() && bus->isOk()) {
           BusDigital &busd = static_cast<BusDigital&>(*bus);
           if (busd.getLEDCurrent() > 0)  // skip buses with LED current set to 0
-            busd.applyBriLimit(newBri);
+            _ablLimited |= busd.applyBriLimit(newBri);
         }
       }
     }
@@ -1451,3 +1454,4 @@ std::vector<std::unique_ptr<Bus>> BusManager::busses;
 uint16_t BusManager::_gMilliAmpsUsed = 0;
 uint16_t BusManager::_gMilliAmpsMax = ABL_MILLIAMPS_DEFAULT;
 bool BusManager::_useABL = false;
+bool BusManager::_ablLimited = false;
@@ -260,7 +260,7 @@ class BusDigital : public Bus {
     uint16_t getMaxCurrent() const override  { return _milliAmpsMax; }
     void     setCurrentLimit(uint16_t milliAmps) { _milliAmpsLimit = milliAmps; }
     void     estimateCurrent(); // estimate used current from summed colors
-    void     applyBriLimit(uint8_t newBri);
+    bool     applyBriLimit(uint8_t newBri);
     size_t   getBusSize() const override;
     void begin() override;
     void cleanup();
@@ -481,6 +481,7 @@ namespace BusManager {
   extern uint16_t _gMilliAmpsUsed;
   extern uint16_t _gMilliAmpsMax;
   extern bool     _useABL;
+  extern bool     _ablLimited; // brightness was reduced by ABL in last show()
 
   #ifdef ESP32_DATA_IDLE_HIGH
   void    esp32RMTInvertIdle() ;
@@ -495,6 +496,7 @@ namespace BusManager {
   inline uint16_t currentMilliamps()            { return _gMilliAmpsUsed + MA_FOR_ESP; }
   //inline uint16_t ablMilliampsMax()             { unsigned sum = 0; for (auto &bus : busses) sum += bus->getMaxCurrent(); return sum; }
   inline uint16_t ablMilliampsMax()             { return _gMilliAmpsMax; }  // used for compatibility reasons (and enabling virtual global ABL)
+  inline bool     ablLimited()                  { return _ablLimited; }
   inline void     setMilliampsMax(uint16_t max) { _gMilliAmpsMax = max;}
   void            initializeABL();              // setup automatic brightness limiter parameters, call once after buses are initialized
   void            applyABL();                   // apply automatic brightness limiter, global or per bus
@@ -544,6 +544,7 @@ bool deserializeConfig(JsonObject doc, bool fromFS) {
   JsonObject def = doc["def"];
   CJSON(bootPreset, def["ps"]);
   CJSON(turnOnAtBoot, def["on"]); // true
+  CJSON(fastStart, def[F("fast")]);
   CJSON(briS, def["bri"]); // 128
 
   JsonObject interfaces = doc["if"];
@@ -575,6 +576,7 @@ bool deserializeConfig(JsonObject doc, bool fromFS) {
   CJSON(syncGroups, if_sync_send["grp"]);
   if (if_sync_send[F("twice")]) udpNumRetries = 1; // import setting from 0.13 and earlier
   CJSON(udpNumRetries, if_sync_send["ret"]);
+  CJSON(notifyWindow, if_sync_send[F("merge")]);
 
   JsonObject if_nodes = interfaces["nodes"];
   CJSON(nodeListEnabled, if_nodes[F("list")]);
@@ -587,6 +589,8 @@ bool deserializeConfig(JsonObject doc, bool fromFS) {
   CJSON(e131Port, if_live["port"]); // 5568
   if (e131Port == DDP_DEFAULT_PORT) e131Port = E131_DEFAULT_PORT; // prevent double DDP port allocation
   CJSON(e131Multicast, if_live[F("mc")]);
+  CJSON(ddpJitterMs, if_live[F("jbuf")]);
+  if (ddpJitterMs > 500) ddpJitterMs = 500;
 
   JsonObject if_live_dmx = if_live["dmx"];
   CJSON(e131Universe, if_live_dmx[F("uni")]);
@@ -764,16 +768,107 @@ bool deserializeConfig(JsonObject doc, bool fromFS) {
 }
 
 static const char s_cfg_json[] PROGMEM = "/cfg.json";
+static const char s_cfg_bin[]  PROGMEM = "/cfg.bin";
+
+/*
+ * Binary config snapshot (/cfg.bin): MessagePack copy of cfg.json, written whenever cfg.json was parsed or saved.
+ * At boot it is decoded instead of parsing cfg.json if format, firmware version and size and modification time of
+ * cfg.json match (cfg.json is not read at all). cfg.json remains the source of truth: uploading or restoring it
+ * removes the snapshot (invalidateConfigSnapshot()), any other change is caught by its size or modification time.
+ */
+#define CFG_SNAPSHOT_MAGIC  0x47464357UL // "WCFG"
+#define CFG_SNAPSHOT_FORMAT 2
+
+typedef struct CfgSnapshotHeader {
+  uint32_t magic;
+  uint16_t format;
+  uint16_t reserved;
+  uint32_t vid;      // VERSION of the firmware that wrote the snapshot
+  uint32_t jsonSize; // cfg.json the snapshot was created from
+  uint32_t jsonTime; // modification time of cfg.json
+  uint32_t dataLen;  // MessagePack data following the header
+  uint32_t dataHash;
+} cfg_snapshot_t;
+
+// size and modification time of cfg.json (file is not read), false if it does not exist
+static bool statConfigFile(uint32_t &size, uint32_t &time) {
+  File f = WLED_FS.open(FPSTR(s_cfg_json), "r");
+  if (!f) return false;
+  size = f.size();
+  time = f.getLastWrite();
+  f.close();
+  return size > 0;
+}
+
+// reads the header, true if the snapshot belongs to cfg.json of the given size and time and to this firmware
+static bool readSnapshotHeader(File &f, cfg_snapshot_t &hdr, uint32_t jsonSize, uint32_t jsonTime) {
+  return f.read(reinterpret_cast<uint8_t*>(&hdr), sizeof(hdr)) == sizeof(hdr) &&
+         hdr.magic == CFG_SNAPSHOT_MAGIC && hdr.format == CFG_SNAPSHOT_FORMAT && hdr.vid == VERSION &&
+         hdr.jsonSize == jsonSize && hdr.jsonTime == jsonTime && hdr.dataLen == f.size() - sizeof(hdr);
+}
+
+static bool configSnapshotMatches(uint32_t jsonSize, uint32_t jsonTime) {
+  File f = WLED_FS.open(FPSTR(s_cfg_bin), "r");
+  if (!f) return false;
+  cfg_snapshot_t hdr;
+  bool match = readSnapshotHeader(f, hdr, jsonSize, jsonTime);
+  f.close();
+  return match;
+}
+
+static void writeConfigSnapshot(JsonObject root) {
+  uint32_t jsonSize, jsonTime;
+  if (!statConfigFile(jsonSize, jsonTime)) return;
+  HashPrint hp;
+  serializeMsgPack(root, hp);
+  cfg_snapshot_t hdr = {CFG_SNAPSHOT_MAGIC, CFG_SNAPSHOT_FORMAT, 0, VERSION, jsonSize, jsonTime, (uint32_t)hp.size(), hp.hash()};
+  File f = WLED_FS.open(FPSTR(s_cfg_bin), "w");
+  if (!f) return;
+  f.write(reinterpret_cast<const uint8_t*>(&hdr), sizeof(hdr));
+  serializeMsgPack(root, f);
+  f.close();
+  DEBUG_PRINTF_P(PSTR("Config snapshot written (%u bytes).\n"), (unsigned)hdr.dataLen);
+}
+
+// loads the snapshot into doc if it matches cfg.json
+// decoded from the file (no buffer besides doc), the data is checked in a first pass with a small buffer
+static bool loadConfigSnapshot(JsonDocument *doc) {
+  uint32_t jsonSize, jsonTime;
+  if (!statConfigFile(jsonSize, jsonTime)) return false;
+  File f = WLED_FS.open(FPSTR(s_cfg_bin), "r");
+  if (!f) return false;
+  cfg_snapshot_t hdr;
+  bool ok = readSnapshotHeader(f, hdr, jsonSize, jsonTime);
+  if (ok) {
+    uint8_t buf[128];
+    HashPrint hp;
+    size_t len;
+    while ((len = f.read(buf, sizeof(buf))) > 0) hp.write(buf, len);
+    ok = hp.size() == hdr.dataLen && hp.hash() == hdr.dataHash && f.seek(sizeof(hdr)) &&
+         deserializeMsgPack(*doc, f) == DeserializationError::Ok; // stream input: strings are copied into doc
+  }
+  f.close();
+  if (ok) DEBUG_PRINTLN(F("Config loaded from snapshot."));
+  return ok;
+}
+
+// cfg.json was replaced (upload, restore), the snapshot must not be used
+void invalidateConfigSnapshot() {
+  WLED_FS.remove(FPSTR(s_cfg_bin));
+}
 
 bool backupConfig() {
   return backupFile(s_cfg_json);
 }
 
 bool restoreConfig() {
+  invalidateConfigSnapshot();
   return restoreFile(s_cfg_json);
 }
 
 bool verifyConfig() {
+  uint32_t size, time;
+  if (statConfigFile(size, time) && configSnapshotMatches(size, time)) return true; // snapshot was created from this (valid) file
   return validateJsonFile(s_cfg_json);
 }
 
@@ -789,6 +884,7 @@ void resetConfig() {
     char backupname[32];
     snprintf_P(backupname, sizeof(backupname), PSTR("/rst.%s"), &s_cfg_json[1]);
     WLED_FS.rename(s_cfg_json, backupname);
+    invalidateConfigSnapshot();
     doReboot = true;
   }
 }
@@ -805,7 +901,10 @@ bool deserializeConfigFromFS() {
 
   DEBUG_PRINTLN(F("Reading settings from /cfg.json..."));
 
-  success = readObjectFromFile(s_cfg_json, nullptr, pDoc);
+  if (!loadConfigSnapshot(pDoc)) {
+    success = readObjectFromFile(s_cfg_json, nullptr, pDoc);
+    if (success && !pDoc->overflowed() && pDoc->is<JsonObject>()) writeConfigSnapshot(pDoc->as<JsonObject>());
+  }
 
   // NOTE: This routine deserializes *and* applies the configuration
   //       Therefore, must also initialize ethernet from this function
@@ -829,8 +928,11 @@ void serializeConfigToFS() {
   serializeConfig(root);
 
   File f = WLED_FS.open(FPSTR(s_cfg_json), "w");
-  if (f) serializeJson(root, f);
-  f.close();
+  if (f) {
+    serializeJson(root, f);
+    f.close();
+    writeConfigSnapshot(root);
+  }
   releaseJSONBufferLock();
 
   configNeedsWrite = false;
@@ -1080,6 +1182,7 @@ void serializeConfig(JsonObject root) {
   JsonObject def = root.createNestedObject("def");
   def["ps"] = bootPreset;
   def["on"] = turnOnAtBoot;
+  def[F("fast")] = fastStart;
   def["bri"] = briS;
 
   JsonObject interfaces = root.createNestedObject("if");
@@ -1109,6 +1212,7 @@ void serializeConfig(JsonObject root) {
   if_sync_send["hue"] = notifyHue;
   if_sync_send["grp"] = syncGroups;
   if_sync_send["ret"] = udpNumRetries;
+  if_sync_send[F("merge")] = notifyWindow;
 
   JsonObject if_nodes = interfaces.createNestedObject("nodes");
   if_nodes[F("list")] = nodeListEnabled;
@@ -1120,6 +1224,7 @@ void serializeConfig(JsonObject root) {
   if_live[F("rlm")] = realtimeRespectLedMaps;
   if_live["port"] = e131Port;
   if_live[F("mc")] = e131Multicast;
+  if_live[F("jbuf")] = ddpJitterMs;
 
   JsonObject if_live_dmx = if_live.createNestedObject("dmx");
   if_live_dmx[F("uni")] = e131Universe;
@@ -291,6 +291,7 @@ void loadCustomPalettes() {
       break;
     }
   }
+  invalidateJsonCache(); // palette pages of JSON API
 }
 
 void hsv2rgb(const CHSV32& hsv, uint32_t& rgb) // convert HSV (16bit hue) to RGB (32bit with white = 0)
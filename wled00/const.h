@@ -253,6 +253,7 @@ static_assert(WLED_MAX_BUSSES <= 32, "WLED_MAX_BUSSES exceeds hard limit");
 #define REALTIME_MODE_TPM2NET     7
 #define REALTIME_MODE_DDP         8
 #define REALTIME_MODE_DMX         9
+#define REALTIME_MODE_WS          10
 
 //realtime override modes
 #define REALTIME_OVERRIDE_NONE    0
@@ -414,6 +415,7 @@ static_assert(WLED_MAX_BUSSES <= 32, "WLED_MAX_BUSSES exceeds hard limit");
 //Playlist option byte
 #define PL_OPTION_SHUFFLE      0x01
 #define PL_OPTION_RESTORE      0x02
+#define PLAYLIST_PREFETCH_TIME 300   // ms before switching to next playlist entry to prefetch its preset
 
 // Segment capability byte
 #define SEG_CAPABILITY_RGB     0x01
@@ -560,6 +562,16 @@ static_assert(WLED_MAX_BUSSES <= 32, "WLED_MAX_BUSSES exceeds hard limit");
   #endif
 #endif
 
+// number of additional JSON documents for serializers of static data (see requestJSONDocument())
+// only with PSRAM by default, each document takes JSON_BUFFER_SIZE of RAM
+#ifndef WLED_JSON_POOL_SIZE
+  #if defined(BOARD_HAS_PSRAM) && !defined(ESP8266)
+    #define WLED_JSON_POOL_SIZE 2
+  #else
+    #define WLED_JSON_POOL_SIZE 0
+  #endif
+#endif
+
 // minimum heap size required to process web requests: try to keep free heap above this value
 #ifdef ESP8266
   #define MIN_HEAP_SIZE (9*1024)
@@ -134,6 +134,40 @@ function connectWs(onOpen) {
 	return ws;
 }
 
+// decode live view frame version 3 (see ws.cpp), s keeps previous frame between calls
+// returns Uint8Array with RGB values, s.w and s.h are set to frame dimensions, s.f to flags (bit 1: 2D)
+function decodeLive(a, s) {
+	let w = (a[4]<<8)|a[5], h = (a[6]<<8)|a[7], n = w*h*3;
+	if ((a[2] & 1) || !s.px || s.px.length != n) s.px = new Uint8Array(n); // key frame
+	let px = s.px, idx = new Uint32Array(64), i = 8, p = 0;
+	while (i < a.length && p < n) {
+		let op = a[i++], cnt = (op & 63) + 1;
+		switch (op >> 6) {
+			case 0: p += cnt*3; break; // skip
+			case 1: { // repeat
+				let r = a[i], g = a[i+1], b = a[i+2]; i += 3;
+				idx[(r*3+g*5+b*7)%64] = (r<<16)|(g<<8)|b;
+				for (; cnt--; p += 3) { px[p] = r; px[p+1] = g; px[p+2] = b; }
+				break;
+			}
+			case 2: // literal
+				for (; cnt--; p += 3, i += 3) {
+					let r = a[i], g = a[i+1], b = a[i+2];
+					idx[(r*3+g*5+b*7)%64] = (r<<16)|(g<<8)|b;
+					px[p] = r; px[p+1] = g; px[p+2] = b;
+				}
+				break;
+			case 3: { // index
+				let c = idx[op & 63];
+				px[p] = (c>>16)&255; px[p+1] = (c>>8)&255; px[p+2] = c&255; p += 3;
+				break;
+			}
+		}
+	}
+	s.w = w; s.h = h; s.f = a[2];
+	return px;
+}
+
 // send LED colors to ESP using WebSocket and DDP protocol (RGB)
 // ws: WebSocket object
 // start: start pixel index
@@ -0,0 +1,128 @@
+#include "wled.h"
+
+/*
+ * Display service: off-screen buffer flushed in the background (see display_fb.h)
+ * Changed tiles are found by comparing a hash of each tile with the hash of the last flushed frame,
+ * adjacent changed tiles of a tile row are sent as one rectangle.
+ */
+
+bool DisplayFramebuffer::begin(const uint8_t *buf, uint16_t width, uint16_t height, uint8_t bytesPerPixel)
+{
+  end();
+  if (!buf || !width || !height || !bytesPerPixel) return false;
+  _cols = (width  + DISPLAY_FB_TILE - 1) / DISPLAY_FB_TILE;
+  _rows = (height + DISPLAY_FB_TILE - 1) / DISPLAY_FB_TILE;
+  _hash = static_cast<uint32_t*>(d_malloc(_cols * _rows * sizeof(uint32_t)));
+  if (!_hash) return false;
+  _buf    = buf;
+  _width  = width;
+  _height = height;
+  _bpp    = bytesPerPixel;
+  _next   = 0;
+  _full   = true;
+  _busy   = false;
+  #ifdef ARDUINO_ARCH_ESP32
+  // same priority as the loop task, on core 0 so it does not compete with the loop (unless single core)
+  xTaskCreateUniversal(
+    [](void *par) {
+      for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY); // wait for commit()
+        static_cast<DisplayFramebuffer*>(par)->flush(UINT32_MAX);
+      }
+    },
+    "display", 3072, this, 1, &_task, 0);
+  if (!_task) { end(); return false; }
+  #else
+  _job = addJob(flushJob, this, 0, DISPLAY_FB_BUDGET_US, DISPLAY_FB_MAX_DELAY, PSTR("display"));
+  if (_job < 0) { end(); return false; }
+  #endif
+  DEBUG_PRINTF_P(PSTR("Display buffer %ux%u, %u tiles.\n"), width, height, _cols * _rows);
+  return true;
+}
+
+void DisplayFramebuffer::end()
+{
+  #ifdef ARDUINO_ARCH_ESP32
+  while (_task && _busy) delay(1); // let the task finish the frame, it must not be deleted while talking to the display
+  if (_task) vTaskDelete(_task);
+  _task = nullptr;
+  #else
+  removeJob(_job);
+  _job = -1;
+  #endif
+  d_free(_hash);
+  _hash = nullptr;
+  _buf  = nullptr;
+  _busy = false;
+}
+
+void DisplayFramebuffer::commit()
+{
+  if (!_hash || _busy) return;
+  _next = 0;
+  _tilesSent = 0;
+  _flushTime = 0;
+  _busy = true;
+  #ifdef ARDUINO_ARCH_ESP32
+  xTaskNotifyGive(_task);
+  #endif
+}
+
+void DisplayFramebuffer::invalidate()
+{
+  _full = true;
+}
+
+uint32_t DisplayFramebuffer::tileHash(unsigned tx, unsigned ty) const
+{
+  const unsigned x = tx * DISPLAY_FB_TILE;
+  const unsigned y = ty * DISPLAY_FB_TILE;
+  const unsigned w = min((unsigned)DISPLAY_FB_TILE, _width  - x) * _bpp;
+  const unsigned h = min((unsigned)DISPLAY_FB_TILE, _height - y);
+  const size_t stride = _width * _bpp;
+  const uint8_t *row = _buf + y * stride + x * _bpp;
+  uint32_t hash = hashBuffer(nullptr, 0); // initial FNV-1a value
+  for (unsigned i = 0; i < h; i++, row += stride) hash = hashBuffer(row, w, hash);
+  return hash;
+}
+
+// checks tiles from _next on and sends the changed ones, returns true once the frame is complete
+bool DisplayFramebuffer::flush(uint32_t budgetUs)
+{
+  if (!_busy) return true;
+  const unsigned long start = micros();
+  const unsigned count = _cols * _rows;
+  int runStart = -1; // first tile of the current run of changed tiles
+
+  while (_next < count) {
+    const unsigned tx = _next % _cols;
+    const unsigned ty = _next / _cols;
+    const uint32_t hash = tileHash(tx, ty);
+    const bool changed = _full || hash != _hash[_next];
+    _hash[_next] = hash;
+    if (changed && runStart < 0) runStart = tx;
+    _next++;
+    // send the run at its end, at the end of the tile row or if the budget is used up
+    const bool outOfTime = micros() - start >= budgetUs;
+    if (runStart >= 0 && (!changed || tx == _cols-1u || outOfTime)) {
+      const unsigned end = changed ? tx + 1 : tx;
+      const unsigned x = runStart * DISPLAY_FB_TILE;
+      const unsigned y = ty * DISPLAY_FB_TILE;
+      _flushFn(_arg, x, y, min(end * DISPLAY_FB_TILE, (unsigned)_width) - x, min((unsigned)DISPLAY_FB_TILE, _height - y));
+      _tilesSent += end - runStart;
+      runStart = -1;
+    }
+    if (outOfTime) break;
+  }
+  _flushTime += micros() - start;
+  if (_next < count) return false;
+  _full = false;
+  _busy = false;
+  return true;
+}
+
+// ESP8266: background job flushing one chunk per run
+void DisplayFramebuffer::flushJob(void *arg)
+{
+  static_cast<DisplayFramebuffer*>(arg)->flush(DISPLAY_FB_BUDGET_US);
+}
@@ -0,0 +1,65 @@
+#pragma once
+#ifndef WLED_DISPLAY_FB_H
+#define WLED_DISPLAY_FB_H
+/*
+ * Display service for usermods driving (slow) I2C/SPI displays
+ * The usermod draws into an off-screen buffer (i.e. the buffer of a TFT_eSprite) and calls commit().
+ * The buffer is then flushed in the background, only tiles that changed since the last flush are sent:
+ * ESP32: by a low priority task on core 0, ESP8266: in chunks by a background job (sched.cpp) within the frame slack.
+ * The buffer must not be drawn into while busy().
+ */
+
+#ifndef DISPLAY_FB_TILE
+  #define DISPLAY_FB_TILE 16           // tile width and height (pixels)
+#endif
+#ifndef DISPLAY_FB_BUDGET_US
+  #define DISPLAY_FB_BUDGET_US 2000    // time per flush chunk (ESP8266)
+#endif
+#ifndef DISPLAY_FB_MAX_DELAY
+  #define DISPLAY_FB_MAX_DELAY 500     // ms a chunk may wait for slack before it is flushed anyway (ESP8266)
+#endif
+
+// sends a rectangle of the buffer to the display
+typedef void (*display_flush_fn_t)(void *arg, uint16_t x, uint16_t y, uint16_t w, uint16_t h);
+
+class DisplayFramebuffer {
+  private:
+    const uint8_t     *_buf = nullptr;
+    display_flush_fn_t _flushFn;
+    void              *_arg;
+    uint32_t          *_hash = nullptr;  // per tile hash of the last flushed frame
+    uint16_t           _width = 0;
+    uint16_t           _height = 0;
+    uint16_t           _cols = 0;        // tiles per row
+    uint16_t           _rows = 0;
+    uint16_t           _next = 0;        // next tile to check (flushing resumes here)
+    uint8_t            _bpp = 0;         // bytes per pixel
+    bool               _full = true;     // flush all tiles (first frame or invalidated)
+    volatile bool      _busy = false;
+    uint16_t           _tilesSent = 0;   // tiles sent for the last frame
+    uint32_t           _flushTime = 0;   // us spent flushing the last frame
+    #ifdef ARDUINO_ARCH_ESP32
+    TaskHandle_t       _task = nullptr;
+    #else
+    int                _job = -1;
+    #endif
+
+    uint32_t tileHash(unsigned tx, unsigned ty) const;
+    bool flush(uint32_t budgetUs);
+    static void flushJob(void *arg);
+
+  public:
+    DisplayFramebuffer(display_flush_fn_t fn, void *arg = nullptr) : _flushFn(fn), _arg(arg) {}
+    ~DisplayFramebuffer() { end(); }
+
+    // buf: row major, bytesPerPixel bytes per pixel (i.e. 2 for a 16 bit TFT_eSprite); returns false if out of memory
+    bool begin(const uint8_t *buf, uint16_t width, uint16_t height, uint8_t bytesPerPixel);
+    void end();
+    void commit();           // frame is complete, flush changed tiles
+    void invalidate();       // resend all tiles with the next commit (i.e. after the display was reset)
+    inline bool busy() const { return _busy; }
+    inline uint32_t getFlushTime() const { return _flushTime; }
+    inline uint16_t getTilesSent() const { return _tilesSent; }
+};
+
+#endif
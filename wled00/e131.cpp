@@ -4,24 +4,220 @@
 #define MAX_4_CH_LEDS_PER_UNIVERSE 128
 #define MAX_CHANNELS_PER_UNIVERSE 512
 
+#define E131_SYNC_TIMEOUT   2500 // E1.31: revert to unsynchronized output if no sync packet within network data loss timeout
+#define ARTNET_SYNC_TIMEOUT 4000 // Art-Net 4: revert to non-synchronous mode if no ArtSync for 4s
+
+#ifndef DDP_JITTER_SLOTS
+  #ifdef ESP8266
+    #define DDP_JITTER_SLOTS 3     // number of frame buffers in DDP jitter buffer (one is always being received into)
+  #else
+    #define DDP_JITTER_SLOTS 4
+  #endif
+#endif
+
 /*
  * E1.31 handler
  */
 
+static unsigned long lastE131Sync   = 0; // millis() of last accepted E1.31 sync packet
+static unsigned long lastArtnetSync = 0; // millis() of last accepted ArtSync packet
+static uint16_t      e131SyncUniverse = 0; // synchronization address announced by E1.31 sender (0 = unsynchronized)
+
+// returns true if sender uses synchronization and received data must be held until sync packet arrives
+static bool isSyncPending(uint8_t mde) {
+  switch (mde) {
+    case REALTIME_MODE_E131:   return e131SyncUniverse && lastE131Sync && millis() - lastE131Sync < E131_SYNC_TIMEOUT;
+    case REALTIME_MODE_ARTNET: return lastArtnetSync && millis() - lastArtnetSync < ARTNET_SYNC_TIMEOUT;
+    default:                   return false;
+  }
+}
+
+// all universes of a synchronized frame have been received, show them at once
+static void handleSyncPacket(uint8_t mde, IPAddress clientIP) {
+  if (realtimeMode != mde || realtimeIP != clientIP) return; // only accept sync from the source we are receiving data from
+  if (mde == REALTIME_MODE_E131) lastE131Sync = millis();
+  else                           lastArtnetSync = millis();
+  if (realtimeOverride) return;
+  e131SyncFrame = true;
+  e131NewData = true;
+}
+
+/*
+ * DDP jitter buffer
+ * complete frames are queued (single producer: network callback, single consumer: main loop)
+ * and presented at a steady cadence derived from DDP timecode or smoothed arrival time
+ * Buffers are only allocated and freed by the main loop, the network callback requests them (wanted)
+ * and marks the receive slot in use (writing) so they are not freed while it copies data.
+ */
+
+static struct {
+  uint8_t       *frames = nullptr;           // DDP_JITTER_SLOTS frames of RGBW data
+  unsigned       frameLen = 0;               // pixels per frame
+  unsigned long  pts[DDP_JITTER_SLOTS];      // presentation time (millis()) of each queued frame
+  volatile uint8_t writeIdx = 0;             // slot being received into (owned by network callback)
+  volatile uint8_t readIdx = 0;              // next slot to present (owned by main loop)
+  unsigned long  lastArrival = 0;            // arrival of last complete frame
+  unsigned long  lastPts = 0;                // presentation time of last queued frame
+  unsigned       avgInterval = 0;            // smoothed frame interval (ms)
+  uint32_t       tcAnchor = 0;               // sender timecode (1/65536 s) mapped to...
+  unsigned long  tcLocalAnchor = 0;          // ...this local time
+  bool           anchored = false;
+  volatile bool  wanted = false;             // network callback needs buffers (allocated by main loop)
+  volatile bool  writing = false;            // network callback is copying into the receive slot
+} jb;
+
+#ifdef ARDUINO_ARCH_ESP32
+static portMUX_TYPE jbMux = portMUX_INITIALIZER_UNLOCKED; // guards frames, writing and the index handoff
+#endif
+
+static inline void lockJitterBuffer() {
+  #ifdef ARDUINO_ARCH_ESP32
+  portENTER_CRITICAL(&jbMux);
+  #endif
+}
+
+static inline void unlockJitterBuffer() {
+  #ifdef ARDUINO_ARCH_ESP32
+  portEXIT_CRITICAL(&jbMux);
+  #endif
+}
+
+// network callback: returns receive slot and marks it in use until releaseJitterSlot(),
+// nullptr if jitter buffer is disabled or buffers are not (yet) allocated (render directly)
+static uint8_t *getJitterSlot() {
+  if (!ddpJitterMs) return nullptr;
+  uint8_t *slot = nullptr;
+  lockJitterBuffer();
+  if (jb.frames) {
+    slot = jb.frames + jb.writeIdx * jb.frameLen * 4;
+    jb.writing = true;
+  } else jb.wanted = true;
+  unlockJitterBuffer();
+  return slot;
+}
+
+static void releaseJitterSlot() {
+  lockJitterBuffer();
+  jb.writing = false;
+  unlockJitterBuffer();
+}
+
+// frame in receive slot is complete, calculate its presentation time and queue it
+static void queueJitterFrame(bool hasTimecode, uint32_t timecode) {
+  const unsigned long now = millis();
+  unsigned long target;
+  ddpStats.received++;
+
+  if (jb.lastArrival && now - jb.lastArrival < 1000) jb.avgInterval = jb.avgInterval ? (7 * jb.avgInterval + (now - jb.lastArrival)) / 8 : now - jb.lastArrival;
+  jb.lastArrival = now;
+
+  if (hasTimecode) {
+    // map sender clock onto local clock; anchor follows the fastest observed transit and relaxes slowly to follow clock drift
+    long tcMs = ((int64_t)(int32_t)(timecode - jb.tcAnchor) * 1000) >> 16;
+    long late = (long)(now - (jb.tcLocalAnchor + tcMs));
+    if (!jb.anchored || late > 1000 || late < -1000) { // first frame or discontinuity (sender restarted)
+      jb.tcAnchor = timecode;
+      jb.tcLocalAnchor = now;
+      jb.anchored = true;
+      tcMs = 0;
+    } else if (late < 0) jb.tcLocalAnchor += late;
+    else if (late > 0)   jb.tcLocalAnchor++;
+    target = jb.tcLocalAnchor + tcMs + ddpJitterMs;
+  } else {
+    // no timecode: continue steady cadence unless arrival drifted outside of jitter window
+    target = jb.lastPts + jb.avgInterval;
+    const unsigned long arrivalTarget = now + ddpJitterMs;
+    long drift = (long)(target - arrivalTarget);
+    if (!jb.lastPts || !jb.avgInterval || drift > (long)ddpJitterMs || drift < -(long)ddpJitterMs) target = arrivalTarget;
+  }
+  jb.lastPts = target;
+
+  lockJitterBuffer();
+  uint8_t next = (jb.writeIdx + 1) % DDP_JITTER_SLOTS;
+  if (next == jb.readIdx) { // queue full, drop this frame (slot will be reused for next one)
+    ddpStats.dropped++;
+  } else {
+    jb.pts[jb.writeIdx] = target;
+    jb.writeIdx = next; // hands slot over to main loop
+  }
+  unlockJitterBuffer();
+}
+
+// called from main loop, presents due frames
+void handleDDPJitterBuffer() {
+  const bool active = realtimeMode == REALTIME_MODE_DDP && ddpJitterMs;
+  if (!jb.frames) {
+    if (!jb.wanted) return;
+    jb.wanted = false;
+    if (!active) return;
+    const unsigned len = strip.getLengthTotal();
+    uint8_t *frames = static_cast<uint8_t*>(allocate_buffer(DDP_JITTER_SLOTS * len * 4, BFRALLOC_PREFER_PSRAM | BFRALLOC_CLEAR));
+    if (!frames) return; // not enough memory, callback keeps rendering directly (and asks again)
+    jb.frameLen = len;
+    jb.writeIdx = jb.readIdx = 0;
+    jb.lastArrival = jb.lastPts = jb.avgInterval = 0;
+    jb.anchored = false;
+    lockJitterBuffer();
+    jb.frames = frames; // publish to network callback
+    unlockJitterBuffer();
+    return;
+  }
+  if (!active || jb.frameLen != strip.getLengthTotal()) {
+    // stream ended or settings changed, release buffers (unless the callback is copying into them, retry next loop)
+    uint8_t *frames = nullptr;
+    lockJitterBuffer();
+    if (!jb.writing) {
+      frames = jb.frames;
+      jb.frames = nullptr;
+    }
+    unlockJitterBuffer();
+    p_free(frames);
+    return;
+  }
+  const unsigned long now = millis();
+  lockJitterBuffer();
+  const uint8_t writeIdx = jb.writeIdx; // slots up to writeIdx (and their pts) are owned by the main loop
+  unlockJitterBuffer();
+  uint8_t readIdx = jb.readIdx;
+  while (readIdx != writeIdx) {
+    if ((long)(jb.pts[readIdx] - now) > 0) break; // not due yet
+    uint8_t next = (readIdx + 1) % DDP_JITTER_SLOTS;
+    if (next != writeIdx && (long)(jb.pts[next] - now) <= 0) { // a newer frame is due as well, skip stale one
+      ddpStats.late++;
+      readIdx = next;
+      continue;
+    }
+    if (!realtimeOverride) {
+      setRealtimePixels(0, jb.frames + readIdx * jb.frameLen * 4, jb.frameLen, true);
+      if (useMainSegmentOnly) strip.trigger();
+      else                    strip.show();
+      ddpStats.shown++;
+      rtStatsShown();
+    }
+    readIdx = next;
+    break;
+  }
+  lockJitterBuffer();
+  jb.readIdx = readIdx; // hands presented slots back to network callback
+  unlockJitterBuffer();
+}
+
 //DDP protocol support, called by handleE131Packet
 //handles RGB data only
 void handleDDPPacket(e131_packet_t* p) {
   static bool ddpSeenPush = false;  // have we seen a push yet?
   int lastPushSeq = e131LastSequenceNumber[0];
+  int ddpSeq = p->sequenceNum & 0xF; // 1..15, 0 if sequence numbers are not used
+  rtStatsPacket(REALTIME_MODE_DDP, 0, htons(p->dataLen), ddpSeq ? ddpSeq - 1 : -1, 15);
 
   //reject late packets belonging to previous frame (assuming 4 packets max. before push)
   if (e131SkipOutOfSequence && lastPushSeq) {
-    int sn = p->sequenceNum & 0xF;
+    int sn = ddpSeq;
     if (sn) {
       if (lastPushSeq > 5) {
-        if (sn > (lastPushSeq -5) && sn < lastPushSeq) return;
+        if (sn > (lastPushSeq -5) && sn < lastPushSeq) { rtStatsDrop(REALTIME_MODE_DDP); return; }
       } else {
-        if (sn > (10 + lastPushSeq) || sn < lastPushSeq) return;
+        if (sn > (10 + lastPushSeq) || sn < lastPushSeq) { rtStatsDrop(REALTIME_MODE_DDP); return; }
       }
     }
   }
@@ -34,7 +230,12 @@ void handleDDPPacket(e131_packet_t* p) {
   unsigned stop = start + dataLen / ddpChannelsPerLed;
   uint8_t* data = p->data;
   unsigned c = 0;
-  if (p->flags & DDP_TIMECODE_FLAG) c = 4; //packet has timecode flag, we do not support it, but data starts 4 bytes later
+  bool hasTimecode = p->flags & DDP_TIMECODE_FLAG;
+  uint32_t timecode = 0;
+  if (hasTimecode) { // packet has timecode (used by jitter buffer), data starts 4 bytes later
+    timecode = (data[0] << 24) | (data[1] << 16) | (data[2] << 8) | data[3];
+    c = 4;
+  }
 
   unsigned numLeds = stop - start; // stop >= start is guaranteed
   unsigned maxDataIndex = c + numLeds * ddpChannelsPerLed; // validate bounds before accessing data array
@@ -46,27 +247,40 @@ void handleDDPPacket(e131_packet_t* p) {
   if (realtimeMode != REALTIME_MODE_DDP) ddpSeenPush = false; // just starting, no push yet
   realtimeLock(realtimeTimeoutMs, REALTIME_MODE_DDP);
 
-  if (!realtimeOverride) {
-    for (unsigned i = start; i < stop; i++, c += ddpChannelsPerLed) {
-      setRealtimePixel(i, data[c], data[c+1], data[c+2], ddpChannelsPerLed >3 ? data[c+3] : 0);
+  bool push = p->flags & DDP_PUSH_FLAG;
+  ddpSeenPush |= push;
+  bool frameComplete = !ddpSeenPush || push; // if we've never seen a push, or this is one, render display
+
+  uint8_t *slot = getJitterSlot();
+  if (slot) {
+    // copy into jitter buffer frame (always RGBW), presented by handleDDPJitterBuffer()
+    const unsigned end = std::min(stop, jb.frameLen);
+    for (unsigned i = start; i < end; i++, c += ddpChannelsPerLed) {
+      uint8_t *px = slot + i * 4;
+      px[0] = data[c]; px[1] = data[c+1]; px[2] = data[c+2];
+      px[3] = ddpChannelsPerLed > 3 ? data[c+3] : 0;
     }
+    if (frameComplete) queueJitterFrame(hasTimecode, timecode);
+    releaseJitterSlot();
+  } else {
+    if (!realtimeOverride) setRealtimePixels(start, &data[c], numLeds, ddpChannelsPerLed > 3);
+    if (frameComplete) e131NewData = true;
   }
 
-  bool push = p->flags & DDP_PUSH_FLAG;
-  ddpSeenPush |= push;
-  if (!ddpSeenPush || push) { // if we've never seen a push, or this is one, render display
-    e131NewData = true;
-    int sn = p->sequenceNum & 0xF;
-    if (sn) e131LastSequenceNumber[0] = sn;
+  if (frameComplete) {
+    if (ddpSeq) e131LastSequenceNumber[0] = ddpSeq;
+    rtStatsFrame(REALTIME_MODE_DDP);
   }
 }
 
 //E1.31 and Art-Net protocol support
 void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol){
+  TraceScope trace(TRACE_E131, protocol);
 
   int uni = 0, dmxChannels = 0;
   uint8_t* e131_data = nullptr;
   int seq = 0, mde = REALTIME_MODE_E131;
+  uint16_t syncUni = 0;
 
   if (protocol == P_ARTNET)
   {
@@ -74,12 +288,21 @@ void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol){
       handleArtnetPollReply(clientIP);
       return;
     }
+    if (p->art_opcode == ARTNET_OPCODE_OPSYNC) {
+      handleSyncPacket(REALTIME_MODE_ARTNET, clientIP);
+      return;
+    }
     uni = p->art_universe;
     dmxChannels = htons(p->art_length);
     e131_data = p->art_data;
     seq = p->art_sequence_number;
     mde = REALTIME_MODE_ARTNET;
   } else if (protocol == P_E131) {
+    if (htonl(p->root_vector) == E131_VECTOR_ROOT_EXTENDED) {
+      // synchronization packet (E1.31: 6.3), applies to universes announcing the same sync address
+      if (e131SyncUniverse && htons(p->sync_address) == e131SyncUniverse) handleSyncPacket(REALTIME_MODE_E131, clientIP);
+      return;
+    }
     // Ignore PREVIEW data (E1.31: 6.2.6)
     if ((p->options & 0x80) != 0) return;
     dmxChannels = htons(p->property_value_count) - 1;
@@ -88,6 +311,7 @@ void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol){
     uni = htons(p->universe);
     e131_data = p->property_values;
     seq = p->sequence_number;
+    syncUni = htons(p->sync_universe);
     if (e131Priority != 0) {
       if (p->priority < e131Priority ) return;
       // track highest priority & skip all lower priorities
@@ -114,12 +338,18 @@ void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol){
 
   unsigned previousUniverses = uni - e131Universe;
 
+  // Art-Net sequence number 0 means sequencing is disabled
+  rtStatsPacket(mde, previousUniverses, dmxChannels, (mde == REALTIME_MODE_ARTNET && seq == 0) ? -1 : seq);
+
   if (e131SkipOutOfSequence)
     if (seq < e131LastSequenceNumber[previousUniverses] && seq > 20 && e131LastSequenceNumber[previousUniverses] < 250){
       DEBUG_PRINTF_P(PSTR("skipping E1.31 frame (last seq=%d, current seq=%d, universe=%d)\n"), e131LastSequenceNumber[previousUniverses], seq, uni);
+      rtStatsDrop(mde, previousUniverses);
       return;
     }
+  rtStatsFrame(mde, previousUniverses);
   e131LastSequenceNumber[previousUniverses] = seq;
+  if (mde == REALTIME_MODE_E131) e131SyncUniverse = syncUni; // only from packets that are used (priority, universe, sequence)
 
   // update status info
   realtimeIP = clientIP;
@@ -321,10 +551,8 @@ void handleDMXData(uint16_t uni, uint16_t dmxChannels, uint8_t* e131_data, uint8
           }
         }
 
-        for (unsigned i = previousLeds; i < ledsTotal; i++) {
-          setRealtimePixel(i, e131_data[dmxOffset], e131_data[dmxOffset+1], e131_data[dmxOffset+2], is4Chan ? e131_data[dmxOffset+3] : 0);
-          dmxOffset += dmxChannelsPerLed;
-        }
+        // whole universe payload is copied in one pass
+        setRealtimePixels(previousLeds, &e131_data[dmxOffset], ledsTotal - previousLeds, is4Chan);
         break;
       }
     default:
@@ -333,7 +561,7 @@ void handleDMXData(uint16_t uni, uint16_t dmxChannels, uint8_t* e131_data, uint8
       break;
   }
 
-  e131NewData = true;
+  if (!isSyncPending(mde)) e131NewData = true; // synchronized frames are shown once sync packet arrives
 }
 
 void handleArtnetPollReply(IPAddress ipAddress) {
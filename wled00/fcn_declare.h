@@ -26,6 +26,7 @@ void IRAM_ATTR touchButtonISR();
 //cfg.cpp
 bool backupConfig();
 bool restoreConfig();
+void invalidateConfigSnapshot();
 bool verifyConfig();
 bool configBackupExists();
 void resetConfig();
@@ -83,6 +84,13 @@ void initDMXInput();
 void handleDMXInput();
 
 //e131.cpp
+typedef struct DDPJitterStats {
+  uint32_t received;  // complete frames received
+  uint32_t shown;     // frames presented
+  uint32_t dropped;   // frames dropped because jitter buffer was full
+  uint32_t late;      // frames skipped because a newer frame was already due
+} ddp_jitter_stats_t;
+void handleDDPJitterBuffer();
 void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol);
 void handleDMXData(uint16_t uni, uint16_t dmxChannels, uint8_t* e131_data, uint8_t mde, uint8_t previousUniverses);
 void handleArtnetPollReply(IPAddress ipAddress);
@@ -97,6 +105,7 @@ bool readObjectFromFileUsingId(const char* file, uint16_t id, JsonDocument* dest
 bool readObjectFromFile(const char* file, const char* key, JsonDocument* dest, const JsonDocument* filter = nullptr);
 void updateFSInfo();
 void closeFile();
+bool indexPresetsFile();
 inline bool writeObjectToFileUsingId(const String &file, uint16_t id, const JsonDocument* content) { return writeObjectToFileUsingId(file.c_str(), id, content); };
 inline bool writeObjectToFile(const String &file, const char* key, const JsonDocument* content) { return writeObjectToFile(file.c_str(), key, content); };
 inline bool readObjectFromFileUsingId(const String &file, uint16_t id, JsonDocument* dest, const JsonDocument* filter = nullptr) { return readObjectFromFileUsingId(file.c_str(), id, dest); };
@@ -154,13 +163,57 @@ void handleIR();
 #include "src/dependencies/json/ArduinoJson-v6.h"
 #include "src/dependencies/json/AsyncJson-v6.h"
 
+bool deserializeStateFast(const char *json, size_t len);
 bool deserializeState(JsonObject root, byte callMode = CALL_MODE_DIRECT_CHANGE, byte presetId = 0);
 void serializeSegment(const JsonObject& root, const Segment& seg, byte id, bool forPreset = false, bool segmentBounds = true);
 void serializeState(JsonObject root, bool forPreset = false, bool includeBri = true, bool segmentBounds = true, bool selectedSegmentsOnly = false);
 void serializeInfo(JsonObject root);
+bool streamJson(Print &out, bool state, bool info); // caller must hold JSON buffer lock
+size_t measureStreamJson(bool state, bool info);
+// counts bytes written (i.e. to measure serialized output)
+class CountingPrint : public Print {
+  size_t _count = 0;
+  public:
+  size_t write(uint8_t) override { _count++; return 1; }
+  size_t write(const uint8_t *, size_t size) override { _count += size; return size; }
+  size_t count() const { return _count; }
+};
+// writes into fixed size buffer, remembers if data did not fit
+class BufferPrint : public Print {
+  uint8_t *_buf;
+  size_t _size, _len = 0;
+  bool _overflow = false;
+  public:
+  BufferPrint(uint8_t *buf, size_t size) : _buf(buf), _size(size) {}
+  size_t write(uint8_t c) override {
+    if (_len >= _size) { _overflow = true; return 0; }
+    _buf[_len++] = c;
+    return 1;
+  }
+  size_t length() const { return _len; }
+  bool overflowed() const { return _overflow; }
+};
+typedef struct JsonSnapshot {
+  uint32_t generation = 0;     // stateGeneration when serialized
+  uint32_t tagGeneration = 0;  // generation in which content last changed (ETag)
+  uint16_t revision = 0;       // content changes within tagGeneration (ETag)
+  unsigned long created = 0;
+  size_t len = 0;
+  char *data = nullptr;
+  ~JsonSnapshot();
+} json_snapshot_t;
+typedef std::shared_ptr<const JsonSnapshot> json_snapshot_ptr;
+json_snapshot_ptr getJsonSnapshot(bool info);
+void getJsonSnapshotEtag(const JsonSnapshot &snap, char *etag);
 void serializeModeNames(JsonArray arr);
 void serializeModeData(JsonArray fxdata);
 void serveJson(AsyncWebServerRequest* request);
+bool isMsgPackBody(AsyncWebServerRequest* request);
+bool wantsMsgPack(AsyncWebServerRequest* request);
+void serveJsonSuccess(AsyncWebServerRequest* request);
+void prepareMsgPack(JsonVariant root);
+void invalidateJsonCache();
+void handleJsonCache();
 #ifdef WLED_ENABLE_JSONLIVE
 bool serveLiveLeds(AsyncWebServerRequest* request, uint32_t wsClient = 0);
 #endif
@@ -209,6 +262,33 @@ void handleOverlayDraw();
 void _overlayAnalogCountdown();
 void _overlayAnalogClock();
 
+//perf.cpp
+enum : uint8_t {
+  PERF_LOOP, PERF_NOTIFY, PERF_USERMODS, PERF_IO, PERF_STRIP, PERF_SHOW, PERF_BUS_SHOW, PERF_WS, PERF_JSON, PERF_WS_EVENT, PERF_JOBS,
+  PERF_STAGE_COUNT
+};
+void perfRecord(uint8_t stage, unsigned long start);
+void perfRecordEffect(unsigned segment, unsigned long start);
+void perfRecordUsermod(unsigned index, unsigned long start);
+void perfReset();
+void serializePerf(JsonObject root);
+// boot phases in the order they run (each one ends at its bootPhase() call), BOOT_FRAME and BOOT_CONNECTED are milestones
+enum : uint8_t {
+  BOOT_INIT, BOOT_FS, BOOT_CFG, BOOT_BUS, BOOT_PALETTES, BOOT_LEDMAP, BOOT_STRIP, BOOT_USERMODS, BOOT_NETWORK, BOOT_SERVER, BOOT_SETUP,
+  BOOT_FRAME, BOOT_CONNECTED,
+  BOOT_PHASE_COUNT
+};
+void bootPhase(uint8_t phase);
+void serializeBootTimes(JsonObject root);
+// records time from construction until end of scope
+class PerfScope {
+  const unsigned long _start;
+  const uint8_t _stage;
+  public:
+  PerfScope(uint8_t stage) : _start(micros()), _stage(stage) {}
+  ~PerfScope() { perfRecord(_stage, _start); }
+};
+
 //playlist.cpp
 void shufflePlaylist();
 void unloadPlaylist();
@@ -216,6 +296,16 @@ int16_t loadPlaylist(JsonObject playlistObject, byte presetId = 0);
 void handlePlaylist();
 void serializePlaylist(JsonObject obj);
 
+//presets_log.cpp
+#ifdef WLED_ENABLE_PRESET_LOG
+int presetLogRead(uint16_t id, JsonDocument* dest, const JsonDocument* filter = nullptr);
+bool presetLogWrite(uint16_t id, const JsonDocument* content);
+bool restorePresetLogSnapshot();
+void initPresetLog();
+bool presetLogMergePending();
+void handlePresetLog();
+#endif
+
 //presets.cpp
 const char *getPresetsFileName(bool persistent = true);
 bool presetNeedsSaving();
@@ -229,23 +319,63 @@ void savePreset(byte index, const char* pname = nullptr, JsonObject saveobj = Js
 inline void saveTemporaryPreset() {savePreset(255);};
 void deletePreset(byte index);
 bool getPresetName(byte index, String& name);
+void prefetchPreset(byte index);
+void applyPresetToUsermods(byte index);
+
+//realtime_stats.cpp
+#define RTSTATS_JITTER_BUCKETS 8
+void rtStatsPacket(uint8_t mode, unsigned index, size_t bytes, int seq = -1, unsigned seqMod = 256);
+void rtStatsFrame(uint8_t mode, unsigned index = 0);
+void rtStatsDrop(uint8_t mode, unsigned index = 0);
+void rtStatsShown();
+void serializeRealtimeStats(JsonObject root);
 
 //remote.cpp
 void handleWiZdata(uint8_t *incomingData, size_t len);
 void handleRemote();
 
+//sched.cpp
+typedef void (*job_fn_t)(void *arg);
+// periodic background job: due every periodMs, runs when budgetUs fits into the frame slack, at the latest maxDelayMs after being due
+int  addJob(job_fn_t fn, void *arg, uint32_t periodMs, uint16_t budgetUs, uint16_t maxDelayMs, const char *name = nullptr);
+void removeJob(int id);
+void triggerJob(int id);
+void handleJobs();
+void serializeJobs(JsonArray arr);
+void resetJobStats();
+
 //set.cpp
 bool isAsterisksOnly(const char* str, byte maxLen);
 void handleSettingsSet(AsyncWebServerRequest *request, byte subPage);
 bool handleSet(AsyncWebServerRequest *request, const String& req, bool apply=true);
 
+//trace.cpp
+#include "trace.h"
+enum : uint8_t {
+  TRACE_SERVICE, TRACE_SHOW, TRACE_BUS_SHOW, TRACE_ABL, TRACE_PRESET_SAVE, TRACE_PRESET_APPLY, TRACE_JSON, TRACE_WS_EVENT, TRACE_E131,
+  TRACE_NAME_COUNT
+};
+void traceInit();
+void traceEvent(uint8_t name, char phase, uint8_t arg = 0);
+void serveTrace(AsyncWebServerRequest* request);
+// records begin event on construction and end event at end of scope
+class TraceScope {
+  const uint8_t _name;
+  public:
+  TraceScope(uint8_t name, uint8_t arg = 0) : _name(name) { traceEvent(name, TRACE_PH_BEGIN, arg); }
+  ~TraceScope() { traceEvent(_name, TRACE_PH_END); }
+};
+
 //udp.cpp
-void notify(byte callMode, bool followUp=false);
+void notify(byte callMode, bool followUp=false, bool force=false);
+void scheduleNotify(byte callMode, bool force=false);
+void scheduleSysInfoUDP();
 uint8_t realtimeBroadcast(uint8_t type, IPAddress client, uint16_t length, const uint8_t* buffer, uint8_t bri=255, bool isRGBW=false);
 void realtimeLock(uint32_t timeoutMs, byte md = REALTIME_MODE_GENERIC);
 void exitRealtime();
 void handleNotifications();
 void setRealtimePixel(uint16_t i, byte r, byte g, byte b, byte w);
+void setRealtimePixels(unsigned start, const byte* data, unsigned count, bool isRGBW);
 void refreshNodeList();
 void sendSysInfoUDP();
 #ifndef WLED_DISABLE_ESPNOW
@@ -362,6 +492,7 @@ namespace UsermodManager {
   void onStateChange(uint8_t);
   Usermod* lookup(uint16_t mod_id);
   size_t getModCount();
+  Usermod* getMod(size_t index); // in registration order
 };
 
 // Register usermods by building a static list via a linker section
@@ -396,6 +527,9 @@ void prepareHostname(char* hostname);
 [[gnu::pure]] bool isAsterisksOnly(const char* str, byte maxLen);
 bool requestJSONBufferLock(uint8_t moduleID=255);
 void releaseJSONBufferLock();
+JsonDocument *requestJSONDocument(uint8_t moduleID=255); // static data only (no state/info), not locked against pDoc writers
+void releaseJSONDocument(JsonDocument *doc);
+void serializeJSONLockStats(JsonObject root);
 uint8_t extractModeName(uint8_t mode, const char *src, char *dest, uint8_t maxLen);
 uint8_t extractModeSlider(uint8_t mode, uint8_t slider, char *dest, uint8_t maxLen, uint8_t *var = nullptr);
 int16_t extractModeDefaults(uint8_t mode, const char *segVar);
@@ -409,6 +543,17 @@ void enumerateLedmaps();
 [[gnu::hot]] uint8_t get_random_wheel_index(uint8_t pos);
 [[gnu::hot, gnu::pure]] float mapf(float x, float in_min, float in_max, float out_min, float out_max);
 uint32_t hashInt(uint32_t s);
+uint32_t hashBuffer(const uint8_t *data, size_t len, uint32_t hash = 2166136261UL);
+// calculates size and hash (hashBuffer()) of written data
+class HashPrint : public Print {
+  uint32_t _hash = hashBuffer(nullptr, 0); // initial FNV-1a value
+  size_t _size = 0;
+  public:
+  size_t write(uint8_t c) override { return write(&c, 1); }
+  size_t write(const uint8_t *buf, size_t len) override { _hash = hashBuffer(buf, len, _hash); _size += len; return len; }
+  uint32_t hash() const { return _hash; }
+  size_t size() const { return _size; }
+};
 int32_t perlin1D_raw(uint32_t x, bool is16bit = false);
 int32_t perlin2D_raw(uint32_t x, uint32_t y, bool is16bit = false);
 int32_t perlin3D_raw(uint32_t x, uint32_t y, uint32_t z, bool is16bit = false);
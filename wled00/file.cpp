@@ -176,6 +176,161 @@ static void writeSpace(size_t l)
   if (knownLargestSpace < l) knownLargestSpace = l;
 }
 
+/*
+ * In-RAM index of root level objects in presets.json (id -> position and length of object)
+ * Avoids scanning the whole file for "<id>": on every preset read or write.
+ * Built once at boot (or on first use) and updated on every write. It is rebuilt if the file
+ * size does not match or files were uploaded, and each hit is verified against the key in the file.
+ */
+typedef struct PresetIndexEntry {
+  uint32_t pos;   // file position of opening '{'
+  uint16_t len;   // object length including braces
+  uint16_t id;
+} preset_index_entry_t;
+
+static std::vector<preset_index_entry_t> presetIndex;
+static size_t presetIndexFileSize = 0;
+static byte presetIndexValidate = 0;
+static bool presetIndexValid = false;
+static int  presetIndexWriteId = -1;    // id of object being written to presets.json, -1 if other file
+
+static bool isPresetsFile(const char *fileName) {
+  return strcmp_P(fileName, getPresetsFileName()) == 0;
+}
+
+// same for a file name that may be in PROGMEM
+static bool isPresetsFileP(const char *file) {
+  char fileName[33]; strncpy_P(fileName, file, 32); fileName[32] = 0; //use PROGMEM safe copy
+  return isPresetsFile(fileName);
+}
+
+// "<id>": key to id, -1 if key is not numeric
+static int keyToId(const char *key) {
+  if (!key || key[0] != '"' || !isdigit(key[1])) return -1;
+  int id = 0;
+  const char *c = key + 1;
+  while (isdigit(*c)) {
+    id = id * 10 + (*c++ - '0');
+    if (id > UINT16_MAX) return -1;
+  }
+  return (c[0] == '"' && c[1] == ':' && c[2] == 0) ? id : -1;
+}
+
+static void invalidatePresetIndex() {
+  presetIndexValid = false;
+  presetIndex.clear();
+}
+
+static preset_index_entry_t *findPresetIndex(unsigned id) {
+  for (auto &e : presetIndex) if (e.id == id) return &e;
+  return nullptr;
+}
+
+static void updatePresetIndex(unsigned id, uint32_t pos, size_t len) {
+  if (!presetIndexValid) return;
+  if (len > UINT16_MAX) { invalidatePresetIndex(); return; }
+  preset_index_entry_t *e = findPresetIndex(id);
+  if (e) { e->pos = pos; e->len = len; }
+  else   presetIndex.push_back({pos, (uint16_t)len, (uint16_t)id});
+}
+
+static void removePresetIndex(unsigned id) {
+  for (auto it = presetIndex.begin(); it != presetIndex.end(); ++it) {
+    if (it->id == id) { presetIndex.erase(it); return; }
+  }
+}
+
+// scan file (opened as f) once and record position and length of each root level object
+static bool buildPresetIndex() {
+  #ifdef WLED_DEBUG_FS
+    DEBUGFS_PRINTLN(F("Build preset index"));
+    uint32_t s = millis();
+  #endif
+  invalidatePresetIndex();
+  if (!f || !f.size()) return false;
+
+  byte buf[FS_BUFSIZE];
+  unsigned depth = 0;
+  bool inString = false, escaped = false, inKey = false;
+  int key = -1;         // numeric root level key preceding the current object
+  int objId = -1;
+  uint32_t objPos = 0;
+  uint32_t pos = 0;
+  f.seek(0);
+  while (pos < f.size()) {
+    size_t bufsize = f.read(buf, FS_BUFSIZE);
+    if (!bufsize) break;
+    for (size_t i = 0; i < bufsize; i++, pos++) {
+      const byte c = buf[i];
+      if (inString) {
+        if (escaped)        escaped = false;
+        else if (c == '\\') escaped = true;
+        else if (c == '"')  inString = inKey = false;
+        else if (inKey)     key = (isdigit(c) && key >= 0 && key < 6553) ? key * 10 + (c - '0') : -2;
+        continue;
+      }
+      switch (c) {
+        case '"':
+          inString = true;
+          if (depth == 1) { inKey = true; key = 0; }
+          break;
+        case '{':
+          if (++depth == 2) { objPos = pos; objId = key; key = -1; }
+          break;
+        case '}':
+          if (depth == 0) break; // malformed
+          if (--depth == 1 && objId >= 0) {
+            size_t len = pos - objPos + 1;
+            if (len > UINT16_MAX) { presetIndex.clear(); return false; } // too large to index, use scanning
+            if (!findPresetIndex(objId)) presetIndex.push_back({objPos, (uint16_t)len, (uint16_t)objId}); // first one wins (like bufferedFind())
+          }
+          break;
+      }
+    }
+  }
+  presetIndexFileSize = f.size();
+  presetIndexValidate = cacheInvalidate;
+  presetIndexValid = true;
+  DEBUGFS_PRINTF("Indexed %u objects, took %lu ms\n", presetIndex.size(), millis() - s);
+  return true;
+}
+
+// make sure index matches presets file opened as f
+static bool checkPresetIndex() {
+  if (presetIndexValid && presetIndexValidate == cacheInvalidate && presetIndexFileSize == f.size()) return true;
+  return buildPresetIndex();
+}
+
+// seek to object with given key using index, returns false if index could not be used
+// found is set to true and file positioned at '{' if object exists
+static bool indexedFind(const char *key, int id, bool &found) {
+  if (id < 0 || !checkPresetIndex()) return false;
+  const preset_index_entry_t *e = findPresetIndex(id);
+  found = (e != nullptr);
+  if (!found) return true;
+  // verify that key is still where the index says it is
+  size_t keyLen = strlen(key);
+  char fileKey[12];
+  if (e->pos >= keyLen && keyLen < sizeof(fileKey) && f.seek(e->pos - keyLen) && f.read((uint8_t*)fileKey, keyLen) == keyLen
+      && !memcmp(fileKey, key, keyLen) && f.peek() == '{') {
+    DEBUGFS_PRINTF("Index hit at pos %u\n", e->pos);
+    return true;
+  }
+  DEBUGFS_PRINTLN(F("Index mismatch!"));
+  invalidatePresetIndex();
+  return false;
+}
+
+bool indexPresetsFile() {
+  if (doCloseFile) closeFile();
+  char fileName[33]; strncpy_P(fileName, getPresetsFileName(), 32); fileName[32] = 0; //use PROGMEM safe copy as FS.open() does not
+  f = WLED_FS.open(fileName, "r");
+  if (!f) return false;
+  bool ok = buildPresetIndex();
+  f.close();
+  return ok;
+}
+
 static bool appendObjectToFile(const char* key, const JsonDocument* content, uint32_t s, uint32_t contentLen = 0)
 {
   #ifdef WLED_DEBUG_FS
@@ -189,6 +344,7 @@ static bool appendObjectToFile(const char* key, const JsonDocument* content, uin
     char init[10];
     strcpy_P(init, PSTR("{\"0\":{}}"));
     f.print(init);
+    invalidatePresetIndex();
   }
 
   if (content->isNull()) {
@@ -202,6 +358,7 @@ static bool appendObjectToFile(const char* key, const JsonDocument* content, uin
   if (bufferedFindSpace(contentLen + strlen(key) + 1)) {
     if (f.position() > 2) f.write(','); //add comma if not first object
     f.print(key);
+    if (presetIndexWriteId >= 0) updatePresetIndex(presetIndexWriteId, f.position(), contentLen);
     serializeJson(*content, f);
     DEBUGFS_PRINTF("Inserted, took %lu ms (total %lu)", millis() - s1, millis() - s);
     doCloseFile = true;
@@ -242,9 +399,11 @@ static bool appendObjectToFile(const char* key, const JsonDocument* content, uin
   } else { //file content is not valid JSON object
     f.seek(0, SeekSet);
     f.print('{'); //start JSON
+    invalidatePresetIndex();
   }
 
   f.print(key);
+  if (presetIndexWriteId >= 0) updatePresetIndex(presetIndexWriteId, f.position(), contentLen);
 
   //Append object
   serializeJson(*content, f);
@@ -257,6 +416,9 @@ static bool appendObjectToFile(const char* key, const JsonDocument* content, uin
 
 bool writeObjectToFileUsingId(const char* file, uint16_t id, const JsonDocument* content)
 {
+  #ifdef WLED_ENABLE_PRESET_LOG
+  if (isPresetsFileP(file)) return presetLogWrite(id, content);
+  #endif
   char objKey[10];
   sprintf(objKey, "\"%d\":", id);
   return writeObjectToFile(file, objKey, content);
@@ -279,15 +441,22 @@ bool writeObjectToFile(const char* file, const char* key, const JsonDocument* co
     return false;
   }
 
-  if (!bufferedFind(key)) //key does not exist in file
+  presetIndexWriteId = isPresetsFile(fileName) ? keyToId(key) : -1;
+  bool found = false;
+  bool indexed = indexedFind(key, presetIndexWriteId, found);
+  if (!indexed) found = bufferedFind(key);
+  if (!found) //key does not exist in file
   {
-    return appendObjectToFile(key, content, s);
+    bool ok = appendObjectToFile(key, content, s);
+    if (presetIndexValid && presetIndexWriteId >= 0) presetIndexFileSize = f.size();
+    return ok;
   }
 
   //an object with this key already exists, replace or delete it
   pos = f.position();
   //measure out end of old object
-  bufferedFindObjectEnd();
+  if (indexed) f.seek(pos + findPresetIndex(presetIndexWriteId)->len);
+  else         bufferedFindObjectEnd();
   size_t pos2 = f.position();
 
   uint32_t oldLen = pos2 - pos;
@@ -307,17 +476,24 @@ bool writeObjectToFile(const char* file, const char* key, const JsonDocument* co
     f.seek(pos);
     serializeJson(*content, f);
     writeSpace(pos2 - f.position());
+    if (presetIndexWriteId >= 0) updatePresetIndex(presetIndexWriteId, pos, contentLen);
   } else if (contentLen && bufferedFindSpace(contentLen - oldLen, false)) { //enough leading spaces to replace
     DEBUGFS_PRINTLN(F("replace (trailing)"));
     f.seek(pos);
     serializeJson(*content, f);
+    if (presetIndexWriteId >= 0) updatePresetIndex(presetIndexWriteId, pos, contentLen);
   } else {
     DEBUGFS_PRINTLN(F("delete"));
     pos -= strlen(key);
     if (pos > 3) pos--; //also delete leading comma if not first object
     f.seek(pos);
     writeSpace(pos2 - pos);
-    if (contentLen) return appendObjectToFile(key, content, s, contentLen);
+    if (presetIndexWriteId >= 0) removePresetIndex(presetIndexWriteId);
+    if (contentLen) {
+      bool ok = appendObjectToFile(key, content, s, contentLen);
+      if (presetIndexValid && presetIndexWriteId >= 0) presetIndexFileSize = f.size();
+      return ok;
+    }
   }
 
   doCloseFile = true;
@@ -327,6 +503,13 @@ bool writeObjectToFile(const char* file, const char* key, const JsonDocument* co
 
 bool readObjectFromFileUsingId(const char* file, uint16_t id, JsonDocument* dest, const JsonDocument* filter)
 {
+  #ifdef WLED_ENABLE_PRESET_LOG
+  if (isPresetsFileP(file)) {
+    if (doCloseFile) closeFile();
+    int found = presetLogRead(id, dest, filter);
+    if (found >= 0) return found;
+  }
+  #endif
   char objKey[10];
   sprintf(objKey, "\"%d\":", id);
   return readObjectFromFile(file, objKey, dest, filter);
@@ -344,7 +527,9 @@ bool readObjectFromFile(const char* file, const char* key, JsonDocument* dest, c
   f = WLED_FS.open(fileName, "r");
   if (!f) return false;
 
-  if (key != nullptr && !bufferedFind(key)) //key does not exist in file
+  bool found = true;
+  if (key != nullptr && !(isPresetsFile(fileName) && indexedFind(key, keyToId(key), found))) found = bufferedFind(key);
+  if (!found) //key does not exist in file
   {
     f.close();
     dest->clear();
@@ -422,6 +607,12 @@ bool handleFileRead(AsyncWebServerRequest* request, String path){
   DEBUGFS_PRINT(F("WS FileRead: ")); DEBUGFS_PRINTLN(path);
   if(path.endsWith("/")) path += "index.htm";
   if(path.indexOf(F("sec")) > -1) return false;
+  #ifdef WLED_ENABLE_PRESET_LOG
+  if (path.endsWith(FPSTR(getPresetsFileName())) && presetLogMergePending()) {
+    request->deferResponse(); // serve once saved presets are merged into presets.json
+    return true;
+  }
+  #endif
   #ifdef BOARD_HAS_PSRAM
   if (path.endsWith(FPSTR(getPresetsFileName()))) {
     size_t psize;
@@ -361,6 +361,275 @@ static bool deserializeSegment(JsonObject elem, byte it, byte presetId = 0)
   return true;
 }
 
+/*
+ * Fast path for small, frequent state updates (i.e. slider drags) that avoids the JSON document:
+ * {"bri":128}, {"on":false,"tt":0}, {"seg":{"fx":3}}, {"tt":0,"seg":[{"col":[[255,0,0]]}]}
+ * Supported keys: bri, on, transition, tt and seg (object or array) with id, col, fx, sx, ix, pal.
+ * Anything else (or any value type deserializeState() would interpret differently) is left to deserializeState().
+ * stateUpdated() is deferred to the main loop, so many updates within one frame cause one notification.
+ * Parsing needs no lock, the JSON buffer lock is only held (not waited for) while the parsed values are applied.
+ */
+#define FAST_STATE_MAX_LEN  192
+#define FAST_STATE_MAX_SEGS 4
+
+#define FAST_SEG_FX  0x01
+#define FAST_SEG_SX  0x02
+#define FAST_SEG_IX  0x04
+#define FAST_SEG_PAL 0x08
+
+typedef struct FastSegUpdate {
+  int      id;       // -1: all selected segments
+  uint8_t  fields;   // FAST_SEG_*
+  uint8_t  colSet;   // bit i: col[i] is set
+  uint8_t  fx, sx, ix, pal;
+  uint32_t col[NUM_COLORS];
+} fast_seg_update_t;
+
+// minimal scanner for flat JSON (no escapes, integers only)
+class FastJsonScanner {
+  const char *_p;
+  const char *_end;
+  public:
+  FastJsonScanner(const char *json, size_t len) : _p(json), _end(json + len) {}
+  void skipSpace()     { while (_p < _end && (*_p == ' ' || *_p == '\t' || *_p == '\r' || *_p == '\n')) _p++; }
+  bool peek(char c)    { skipSpace(); return _p < _end && *_p == c; }
+  bool consume(char c) { if (!peek(c)) return false; _p++; return true; }
+  bool atEnd()         { skipSpace(); return _p >= _end || *_p == '\0'; }
+
+  bool string(char *out, size_t size) {
+    if (!consume('"')) return false;
+    size_t n = 0;
+    while (_p < _end && *_p != '"') {
+      if (*_p == '\\' || n >= size-1) return false;
+      out[n++] = *_p++;
+    }
+    out[n] = '\0';
+    return consume('"');
+  }
+  bool key(char *out, size_t size) { return string(out, size) && consume(':'); }
+
+  bool integer(long &val) {
+    skipSpace();
+    bool neg = _p < _end && *_p == '-';
+    if (neg) _p++;
+    if (_p >= _end || !isdigit(*_p)) return false;
+    val = 0;
+    while (_p < _end && isdigit(*_p)) {
+      if (val > 9999999) return false;
+      val = val * 10 + (*_p++ - '0');
+    }
+    if (_p < _end && (*_p == '.' || *_p == 'e' || *_p == 'E')) return false;
+    if (neg) val = -val;
+    return true;
+  }
+
+  bool boolean(bool &val) {
+    skipSpace();
+    if (_end - _p >= 4 && strncmp_P(_p, PSTR("true"), 4) == 0)  { _p += 4; val = true;  return true; }
+    if (_end - _p >= 5 && strncmp_P(_p, PSTR("false"), 5) == 0) { _p += 5; val = false; return true; }
+    return false;
+  }
+};
+
+// "col":[[r,g,b(,w)],"RRGGBB(WW)",...]
+static bool parseFastColors(FastJsonScanner &s, fast_seg_update_t &u)
+{
+  if (!s.consume('[')) return false;
+  if (s.consume(']')) return true;
+  unsigned i = 0;
+  do {
+    if (i >= NUM_COLORS) return false;
+    if (s.consume('[')) {
+      int rgbw[] = {0,0,0,0};
+      unsigned n = 0;
+      if (!s.consume(']')) {
+        do {
+          long c;
+          if (n >= 4 || !s.integer(c)) return false;
+          rgbw[n++] = c;
+        } while (s.consume(','));
+        if (!s.consume(']')) return false;
+      }
+      if (n) { // empty array leaves color unchanged
+        u.col[i] = RGBW32(rgbw[0],rgbw[1],rgbw[2],rgbw[3]);
+        u.colSet |= 1 << i;
+      }
+    } else {
+      char hexCol[10];
+      byte brgbw[] = {0,0,0,0};
+      if (!s.string(hexCol, sizeof(hexCol))) return false;
+      if (colorFromHexString(brgbw, hexCol)) {
+        u.col[i] = RGBW32(brgbw[0],brgbw[1],brgbw[2],brgbw[3]);
+        u.colSet |= 1 << i;
+      }
+    }
+    i++;
+  } while (s.consume(','));
+  return s.consume(']');
+}
+
+static bool parseFastSegment(FastJsonScanner &s, fast_seg_update_t &u, int id)
+{
+  memset(&u, 0, sizeof(u));
+  u.id = id;
+  if (!s.consume('{')) return false;
+  if (s.consume('}')) return true;
+  do {
+    char key[6];
+    long val;
+    if (!s.key(key, sizeof(key))) return false;
+    if (strcmp_P(key, PSTR("col")) == 0) {
+      if (!parseFastColors(s, u)) return false;
+      continue;
+    }
+    if (!s.integer(val)) return false;
+    if (strcmp_P(key, PSTR("id")) == 0) u.id = val;
+    else if (val < 0) { // ignored by deserializeSegment()
+      if (strcmp_P(key, PSTR("fx")) && strcmp_P(key, PSTR("sx")) && strcmp_P(key, PSTR("ix")) && strcmp_P(key, PSTR("pal"))) return false;
+    }
+    else if (strcmp_P(key, PSTR("fx"))  == 0) { u.fx  = val; u.fields |= FAST_SEG_FX;  }
+    else if (strcmp_P(key, PSTR("sx"))  == 0) { u.sx  = val; u.fields |= FAST_SEG_SX;  }
+    else if (strcmp_P(key, PSTR("ix"))  == 0) { u.ix  = val; u.fields |= FAST_SEG_IX;  }
+    else if (strcmp_P(key, PSTR("pal")) == 0) { u.pal = val; u.fields |= FAST_SEG_PAL; }
+    else return false;
+  } while (s.consume(','));
+  // segments that do not exist yet are created by deserializeSegment()
+  return s.consume('}') && u.id < (int)strip.getSegmentsNum() && (u.id >= 0 || id < 0);
+}
+
+static void applyFastSegment(Segment &seg, const fast_seg_update_t &u)
+{
+  const uint32_t col[] = {seg.colors[0], seg.colors[1], seg.colors[2]};
+  const uint8_t  mode = seg.mode, speed = seg.speed, intensity = seg.intensity, palette = seg.palette;
+
+  if (u.colSet) {
+    if (seg.getLightCapabilities() & 3) {
+      for (size_t i = 0; i < NUM_COLORS; i++) {
+        if (!(u.colSet & (1 << i))) continue;
+        seg.setColor(i, u.col[i]); // use transition
+        if (seg.mode == FX_MODE_STATIC) strip.trigger(); //instant refresh
+      }
+    } else {
+      // non RGB & non White segment (usually On/Off bus)
+      seg.setColor(0, ULTRAWHITE); // use transition
+      seg.setColor(1, BLACK); // use transition
+    }
+  }
+  if (u.fields & FAST_SEG_FX) {
+    if (currentPlaylist >= 0) unloadPlaylist();
+    if (u.fx != seg.mode) seg.setMode(u.fx); // use transition
+  }
+  if (u.fields & FAST_SEG_SX) seg.speed = u.sx;
+  if (u.fields & FAST_SEG_IX) seg.intensity = u.ix;
+  if ((u.fields & FAST_SEG_PAL) && (seg.getLightCapabilities() & 1)) seg.setPalette(u.pal); // ignore palette for White and On/Off segments
+
+  for (size_t i = 0; i < NUM_COLORS; i++) if (col[i] != seg.colors[i]) stateChanged = true;
+  if (mode != seg.mode || speed != seg.speed || intensity != seg.intensity || palette != seg.palette) stateChanged = true;
+}
+
+// unfreeze all segments when turning on
+static void unfreezeSegments()
+{
+  for (size_t s=0; s < strip.getSegmentsNum(); s++) {
+    strip.getSegment(s).freeze = false;
+  }
+  if (realtimeMode && !realtimeOverride && useMainSegmentOnly) { // keep live segment frozen if live
+    strip.getMainSegment().freeze = true;
+  }
+}
+
+// returns false if the update must be handled by deserializeState()
+bool deserializeStateFast(const char *json, size_t len)
+{
+  if (json == nullptr || len == 0 || len > FAST_STATE_MAX_LEN) return false;
+
+  FastJsonScanner s(json, len);
+  long newBri = -1, tr = -1, tt = -1;
+  int  on = -1;
+  fast_seg_update_t segs[FAST_STATE_MAX_SEGS];
+  unsigned segCount = 0;
+
+  if (!s.consume('{')) return false;
+  if (!s.consume('}')) {
+    do {
+      char key[12];
+      long val;
+      bool b;
+      if (!s.key(key, sizeof(key))) return false;
+      if (strcmp_P(key, PSTR("seg")) == 0) {
+        if (segCount) return false; // "seg" given twice
+        if (s.peek('{')) {
+          if (!parseFastSegment(s, segs[segCount++], -1)) return false;
+        } else {
+          if (!s.consume('[')) return false;
+          if (!s.consume(']')) {
+            int it = 0;
+            do {
+              if (segCount >= FAST_STATE_MAX_SEGS || !parseFastSegment(s, segs[segCount++], it++)) return false;
+            } while (s.consume(','));
+            if (!s.consume(']')) return false;
+          }
+        }
+      } else if (strcmp_P(key, PSTR("on")) == 0) {
+        if (!s.boolean(b)) return false; // "t" (toggle) needs deserializeState()
+        on = b;
+      } else {
+        if (!s.integer(val)) return false;
+        if      (strcmp_P(key, PSTR("bri")) == 0)        newBri = val;
+        else if (strcmp_P(key, PSTR("transition")) == 0) tr = val;
+        else if (strcmp_P(key, PSTR("tt")) == 0)         tt = val;
+        else return false;
+      }
+    } while (s.consume(','));
+    if (!s.consume('}')) return false;
+  }
+  if (!s.atEnd()) return false;
+
+  // parsing needs no lock, applying does: handlePresets() may be changing segments
+  if (jsonBufferLock || !requestJSONBufferLock(25)) return false; // busy, deserializeState() path defers (or reports ERR_NOBUF)
+
+  // same order as deserializeState()
+  bool onBefore = bri;
+  if (newBri >= 0) bri = newBri;
+  if (bri != briOld) stateChanged = true;
+
+  if (on >= 0 && !on != !bri) toggleOnOff();
+  if (bri && !onBefore) unfreezeSegments();
+
+  if (tr >= 0) {
+    transitionDelay = tr * 100;
+    strip.setTransition(transitionDelay);
+  }
+  // temporary transition (applies only once)
+  if (tt >= 0) {
+    jsonTransitionOnce = true;
+    strip.setTransition(tt * 100);
+  }
+
+  if (segCount) {
+    // we may be called during strip.service() so we must not modify segments while effects are executing
+    const bool wasSuspended = strip.isSuspended();
+    strip.suspend();
+    strip.waitForIt();
+    for (unsigned i = 0; i < segCount; i++) {
+      if (segs[i].id >= 0) {
+        if (segs[i].id < (int)strip.getSegmentsNum()) applyFastSegment(strip.getSegment(segs[i].id), segs[i]);
+        continue;
+      }
+      //apply to all selected segments
+      for (size_t s = 0; s < strip.getSegmentsNum(); s++) {
+        Segment &sg = strip.getSegment(s);
+        if (sg.isActive() && sg.isSelected()) applyFastSegment(sg, segs[i]);
+      }
+    }
+    if (!wasSuspended) strip.resume(); // do not resume a strip suspended by someone else
+  }
+  releaseJSONBufferLock();
+
+  if (stateChanged) stateUpdatePending = true; // stateUpdated() is called from handleTransitions()
+  return true;
+}
+
 // deserializes WLED state
 // presetId is non-0 if called from handlePreset()
 bool deserializeState(JsonObject root, byte callMode, byte presetId)
@@ -382,14 +651,7 @@ bool deserializeState(JsonObject root, byte callMode, byte presetId)
     if (onBefore || !bri) toggleOnOff(); // do not toggle off again if just turned on by bri (makes e.g. "{"on":"t","bri":32}" work)
   }
 
-  if (bri && !onBefore) { // unfreeze all segments when turning on
-    for (size_t s=0; s < strip.getSegmentsNum(); s++) {
-      strip.getSegment(s).freeze = false;
-    }
-    if (realtimeMode && !realtimeOverride && useMainSegmentOnly) { // keep live segment frozen if live
-      strip.getMainSegment().freeze = true;
-    }
-  }
+  if (bri && !onBefore) unfreezeSegments();
 
   long tr = -1;
   if (!presetId || currentPlaylist < 0) { //do not apply transition time from preset if playlist active, as it would override playlist transition times
@@ -458,6 +720,7 @@ bool deserializeState(JsonObject root, byte callMode, byte presetId)
   JsonVariant segVar = root["seg"];
   if (!segVar.isNull()) {
     // we may be called during strip.service() so we must not modify segments while effects are executing
+    const bool wasSuspended = strip.isSuspended();
     strip.suspend();
     strip.waitForIt();
     if (segVar.is<JsonObject>()) {
@@ -632,7 +895,8 @@ static void serializeSegment(JsonObject& root, const Segment& seg, byte id, bool
   root["bm"]  = seg.blendMode;
 }
 
-void serializeState(JsonObject root, bool forPreset, bool includeBri, bool segmentBounds, bool selectedSegmentsOnly)
+// everything in state except "seg" (which must be last, see streamJson())
+static void serializeStateBase(JsonObject root, bool forPreset, bool includeBri)
 {
   if (includeBri) {
     root["on"] = (bri > 0);
@@ -667,6 +931,11 @@ void serializeState(JsonObject root, bool forPreset, bool includeBri, bool segme
   }
 
   root[F("mainseg")] = strip.getMainSegmentId();
+}
+
+void serializeState(JsonObject root, bool forPreset, bool includeBri, bool segmentBounds, bool selectedSegmentsOnly)
+{
+  serializeStateBase(root, forPreset, includeBri);
 
   JsonArray seg = root.createNestedArray("seg");
   for (size_t s = 0; s < WS2812FX::getMaxSegments(); s++) {
@@ -760,10 +1029,22 @@ void serializeInfo(JsonObject root)
     case REALTIME_MODE_ARTNET:   root["lm"] = F("Art-Net"); break;
     case REALTIME_MODE_TPM2NET:  root["lm"] = F("tpm2.net"); break;
     case REALTIME_MODE_DDP:      root["lm"] = F("DDP"); break;
+    case REALTIME_MODE_WS:       root["lm"] = F("WebSocket"); break;
   }
 
   root[F("lip")] = realtimeIP[0] == 0 ? "" : realtimeIP.toString();
 
+  if (ddpJitterMs) {
+    JsonObject ddp_info = root.createNestedObject(F("ddp"));
+    ddp_info[F("jbuf")]  = ddpJitterMs;
+    ddp_info[F("rx")]    = ddpStats.received;
+    ddp_info[F("shown")] = ddpStats.shown;
+    ddp_info[F("drop")]  = ddpStats.dropped;
+    ddp_info[F("late")]  = ddpStats.late;
+  }
+  serializeRealtimeStats(root);
+  serializeJSONLockStats(root);
+
   #ifdef WLED_ENABLE_WEBSOCKETS
   root[F("ws")] = ws.count();
   #else
@@ -840,6 +1121,7 @@ void serializeInfo(JsonObject root)
   root[F("psram")] = ESP.getFreePsram();
   #endif
   root[F("uptime")] = millis()/1000 + rolloverMillis*4294967;
+  serializeBootTimes(root.createNestedObject(F("boot")));
 
   char time[32];
   getTimeString(time);
@@ -1073,34 +1355,519 @@ void serializeModeNames(JsonArray arr)
   }
 }
 
+/*
+ * Streaming serializer for state and info (used for /json/state, /json/info, /json/si and WebSocket)
+ * Instead of building the whole DOM in the global JSON buffer, the top level state, each segment and
+ * info are serialized one after another into a small document and written to the output.
+ * The same serialize functions are used, so the schema is identical to the DOM output.
+ * The global JSON buffer is not used, but its lock must be held so segments are not changed meanwhile.
+ */
+#ifndef WLED_JSON_STREAM_DOC_SIZE
+  #ifdef ESP8266
+    #define WLED_JSON_STREAM_DOC_SIZE 3072
+  #else
+    #define WLED_JSON_STREAM_DOC_SIZE 6144
+  #endif
+#endif
+
+// swallows the last written character (closing brace of an object that is continued)
+class TrimLastPrint : public Print {
+  Print &_out;
+  int _held = -1;
+  public:
+  TrimLastPrint(Print &out) : _out(out) {}
+  size_t write(uint8_t c) override {
+    if (_held >= 0) _out.write((uint8_t)_held);
+    _held = c;
+    return 1;
+  }
+};
+
+// writes {"state":{...},"info":{...}} or only state or info object piece by piece (state without "seg", each segment, info)
+// segments must not change while streaming: caller has to hold the JSON buffer lock
+class JsonStreamer {
+  DynamicJsonDocument _doc;
+  const bool _state, _info;
+  enum { BEGIN, SEG, INFO, END } _step = BEGIN;
+  size_t _seg = 0;       // next segment to check
+  bool _first = true;    // no segment written yet
+  bool _failed = false;  // a piece did not fit the small document
+  public:
+  JsonStreamer(bool state, bool info) : _doc(WLED_JSON_STREAM_DOC_SIZE), _state(state), _info(info) { _failed = !_doc.capacity(); }
+  bool failed() const { return _failed; }
+
+  // writes next piece, returns false once complete (or failed)
+  bool next(Print &out) {
+    if (_failed) return false;
+    const bool both = _state && _info;
+    switch (_step) {
+      case BEGIN:
+        _step = _state ? SEG : INFO;
+        if (!_state) return true;
+        _doc.clear();
+        serializeStateBase(_doc.to<JsonObject>(), false, true);
+        if (_doc.overflowed()) break;
+        if (both) out.print(F("{\"state\":"));
+        {
+          TrimLastPrint base(out);
+          serializeJson(_doc, base); // without closing brace
+        }
+        out.print(F(",\"seg\":["));
+        return true;
+      case SEG:
+        for (; _seg < strip.getSegmentsNum(); _seg++) {
+          const Segment &sg = strip.getSegment(_seg);
+          if (!sg.isActive()) continue;
+          _doc.clear();
+          JsonObject seg0 = _doc.to<JsonObject>();
+          serializeSegment(seg0, sg, _seg, false, true);
+          if (_doc.overflowed()) break;
+          if (!_first) out.write(',');
+          serializeJson(_doc, out);
+          _first = false;
+          _seg++;
+          return true;
+        }
+        if (_seg < strip.getSegmentsNum()) break; // overflowed
+        out.print(F("]}"));
+        _step = INFO;
+        return true;
+      case INFO:
+        _step = END;
+        if (_info) {
+          _doc.clear();
+          serializeInfo(_doc.to<JsonObject>());
+          if (_doc.overflowed()) break;
+          if (both) out.print(F(",\"info\":"));
+          serializeJson(_doc, out);
+        }
+        if (both) out.write('}');
+        return true;
+      default:
+        return false;
+    }
+    _failed = true;
+    return false;
+  }
+};
+
+// returns false if a piece did not fit the small document
+// WARNING: output is incomplete if false is returned, caller must discard it
+bool streamJson(Print &out, bool state, bool info)
+{
+  JsonStreamer streamer(state, info);
+  while (streamer.next(out));
+  return !streamer.failed();
+}
+
+// returns length of streamed JSON (0 on failure)
+// values may change until the actual output is streamed (i.e. uptime), caller should allow some slack
+size_t measureStreamJson(bool state, bool info)
+{
+  CountingPrint counter;
+  byte err = errorFlag; // serializeState() clears error flag once reported
+  bool ok = streamJson(counter, state, info);
+  errorFlag = err;
+  return ok ? counter.count() : 0;
+}
+
+// chunks of streamed state/info for chunked HTTP responses, holds the JSON buffer lock until the last piece is written
+class JsonChunkSource : public Print {
+  JsonStreamer _streamer;
+  std::vector<uint8_t> _pending; // rest of the current piece
+  size_t _pos = 0;
+  bool _locked = false;
+  void unlock() { if (_locked) releaseJSONBufferLock(); _locked = false; }
+  public:
+  JsonChunkSource(bool state, bool info) : _streamer(state, info) {}
+  ~JsonChunkSource() { unlock(); }
+  bool failed() const { return _streamer.failed(); }
+  void takeLock() { _locked = true; } // JSON buffer lock of the caller is released once streaming is complete
+  size_t write(uint8_t c) override { _pending.push_back(c); return 1; }
+  size_t write(const uint8_t *buf, size_t size) override { _pending.insert(_pending.end(), buf, buf + size); return size; }
+
+  size_t fill(uint8_t *buf, size_t maxLen) {
+    size_t len = 0;
+    while (len < maxLen) {
+      if (_pos >= _pending.size()) {
+        _pending.clear();
+        _pos = 0;
+        if (!_streamer.next(*this)) { unlock(); break; } // complete
+        continue;
+      }
+      const size_t n = std::min(maxLen - len, _pending.size() - _pos);
+      memcpy(buf + len, _pending.data() + _pos, n);
+      len += n;
+      _pos += n;
+    }
+    return len;
+  }
+};
+
+/*
+ * Shared state snapshots (/json/state, /json/si and WebSocket)
+ * State (and state+info) is serialized once per change of stateGeneration and the resulting buffer is shared
+ * by all WebSocket clients and HTTP responses until the next change, so many pollers cost as much as one.
+ * Snapshots are also refreshed after WLED_JSON_SNAPSHOT_AGE as some values change without a state update
+ * (info, nightlight countdown). The ETag only changes if the serialized content differs.
+ * Snapshots are serialized while holding the JSON buffer lock, if it is busy the previous snapshot is served.
+ */
+#ifndef WLED_JSON_SNAPSHOT_AGE
+  #define WLED_JSON_SNAPSHOT_AGE 1000 // ms
+#endif
+
+JsonSnapshot::~JsonSnapshot() { p_free(data); }
+
+static json_snapshot_ptr snapshots[2]; // state, state+info
+static uint16_t snapshotBootId = 0;   // ETags must not match those of a previous boot
+#ifdef ARDUINO_ARCH_ESP32
+static portMUX_TYPE snapshotMux = portMUX_INITIALIZER_UNLOCKED;
+#endif
+
+static json_snapshot_ptr loadSnapshot(bool info) {
+  #ifdef ARDUINO_ARCH_ESP32
+  portENTER_CRITICAL(&snapshotMux); // shared_ptr assignment is not atomic, serveJson() runs in async_tcp task
+  #endif
+  json_snapshot_ptr snap = snapshots[info];
+  #ifdef ARDUINO_ARCH_ESP32
+  portEXIT_CRITICAL(&snapshotMux);
+  #endif
+  return snap;
+}
+
+static void storeSnapshot(bool info, json_snapshot_ptr &snap) {
+  #ifdef ARDUINO_ARCH_ESP32
+  portENTER_CRITICAL(&snapshotMux);
+  #endif
+  snapshots[info].swap(snap); // old snapshot is released outside of critical section
+  #ifdef ARDUINO_ARCH_ESP32
+  portEXIT_CRITICAL(&snapshotMux);
+  #endif
+}
+
+static bool isSnapshotCurrent(const json_snapshot_ptr &snap) {
+  return snap && snap->generation == stateGeneration && errorFlag == ERR_NONE && millis() - snap->created < WLED_JSON_SNAPSHOT_AGE;
+}
+
+// returns current snapshot of state (info == false) or state and info, serializes it if outdated
+// returns the previous snapshot if the JSON buffer is busy (or out of memory), nullptr if there is none
+json_snapshot_ptr getJsonSnapshot(bool info)
+{
+  json_snapshot_ptr old = loadSnapshot(info);
+  if (isSnapshotCurrent(old)) return old;
+  // the lock keeps segments unchanged while serializing and lets only one task build a snapshot
+  if (old && jsonBufferLock) return old; // do not wait, serve previous snapshot
+  if (!requestJSONBufferLock(24)) return old;
+  old = loadSnapshot(info); // may have been built while waiting for the lock
+  if (isSnapshotCurrent(old)) {
+    releaseJSONBufferLock();
+    return old;
+  }
+
+  JsonSnapshot *snap = new(std::nothrow) JsonSnapshot;
+  if (!snap) {
+    releaseJSONBufferLock();
+    return old;
+  }
+  snap->generation = stateGeneration; // before serializing, a change meanwhile outdates this snapshot
+  size_t size = old ? old->len + 64 : 0;
+  for (unsigned attempt = 0; attempt < 2 && !snap->len; attempt++) {
+    if (!size) size = measureStreamJson(true, info) + 32;
+    if (size <= 32) break;
+    p_free(snap->data);
+    snap->data = static_cast<char*>(p_malloc(size));
+    if (!snap->data) break;
+    BufferPrint out((uint8_t*)snap->data, size);
+    if (streamJson(out, true, info) && !out.overflowed()) snap->len = out.length();
+    size = 0; // measure if retrying
+  }
+  if (!snap->len) {
+    releaseJSONBufferLock();
+    delete snap;
+    return old;
+  }
+  snap->created = millis();
+  if (old && old->len == snap->len && !memcmp(old->data, snap->data, snap->len)) {
+    snap->tagGeneration = old->tagGeneration; // unchanged content keeps ETag
+    snap->revision      = old->revision;
+  } else {
+    snap->tagGeneration = snap->generation;
+    snap->revision      = (old && old->tagGeneration == snap->generation) ? old->revision + 1 : 0;
+  }
+  json_snapshot_ptr ptr(snap);
+  json_snapshot_ptr ret = ptr;
+  storeSnapshot(info, ptr);
+  releaseJSONBufferLock(); // after storing, so a waiting task finds the new snapshot
+  DEBUG_PRINTF_P(PSTR("JSON snapshot %u.%u (%u bytes).\n"), snap->tagGeneration, snap->revision, snap->len);
+  return ret;
+}
+
+// etag must hold at least 32 characters
+void getJsonSnapshotEtag(const JsonSnapshot &snap, char *etag)
+{
+  if (!snapshotBootId) snapshotBootId = hw_random16() | 1;
+  sprintf_P(etag, PSTR("\"%04x-%x-%x\""), snapshotBootId, snap.tagGeneration, snap.revision);
+}
+
+// sends shared snapshot without copying it
+class JsonSnapshotResponse : public AsyncAbstractResponse {
+  json_snapshot_ptr _snap;
+  size_t _sent = 0;
+  public:
+  JsonSnapshotResponse(json_snapshot_ptr snap) : _snap(snap) {
+    _code = 200;
+    _contentType = FPSTR(CONTENT_TYPE_JSON);
+    _contentLength = snap->len;
+  }
+  bool _sourceValid() const override { return true; }
+  size_t _fillBuffer(uint8_t *buf, size_t maxLen) override {
+    size_t n = std::min(maxLen, _snap->len - _sent);
+    memcpy(buf, _snap->data + _sent, n);
+    _sent += n;
+    return n;
+  }
+};
+
+// serves state or state+info snapshot, answers 304 if client has the current version
+static bool serveJsonSnapshot(AsyncWebServerRequest* request, bool info)
+{
+  json_snapshot_ptr snap = getJsonSnapshot(info);
+  if (!snap) return false;
+  char etag[32];
+  getJsonSnapshotEtag(*snap, etag);
+  AsyncWebHeader *header = request->getHeader(F("If-None-Match"));
+  AsyncWebServerResponse *response;
+  if (header && header->value() == etag) response = request->beginResponse(304);
+  else                                   response = new JsonSnapshotResponse(snap);
+  response->addHeader(F("Cache-Control"), F("no-cache")); // always revalidate
+  response->addHeader(F("ETag"), etag);
+  request->send(response);
+  return true;
+}
+
+/*
+ * Cache of static JSON API responses: effect names (/json/eff), effect data (/json/fxdata) and palette pages (/json/palx)
+ * They only change if effects are added or custom palettes are (re)loaded, so they are serialized once from the main loop
+ * (one response per loop) and served with a content hash as strong ETag. Without cache memory (ESP8266) only the hash is
+ * kept so browsers can revalidate, the response itself is still serialized on request.
+ */
+#if !defined(ESP8266) && !defined(WLED_DISABLE_JSON_CACHE)
+  #define WLED_JSON_CACHE
+#endif
+#define JSON_CACHE_EFF    0
+#define JSON_CACHE_FXDATA 1
+#define JSON_CACHE_PAL    2 // first palette page
+
+typedef struct JsonCacheEntry {
+  json_snapshot_ptr data; // nullptr if not cached
+  uint32_t hash;          // FNV-1a of serialized response, 0 if not (yet) known
+} json_cache_entry_t;
+
+static std::vector<json_cache_entry_t> jsonCache;
+static bool     jsonCacheDirty = true;
+static unsigned jsonCacheBuildIdx = 0;
+#ifdef ARDUINO_ARCH_ESP32
+static portMUX_TYPE jsonCacheMux = portMUX_INITIALIZER_UNLOCKED;
+#endif
+
+// effects or custom palettes changed
+void invalidateJsonCache()
+{
+  jsonCacheDirty = true;
+}
+
+static bool getJsonCacheEntry(unsigned idx, json_cache_entry_t &entry)
+{
+  bool found = false;
+  #ifdef ARDUINO_ARCH_ESP32
+  portENTER_CRITICAL(&jsonCacheMux);
+  #endif
+  if (!jsonCacheDirty && idx < jsonCache.size() && jsonCache[idx].hash) { entry = jsonCache[idx]; found = true; }
+  #ifdef ARDUINO_ARCH_ESP32
+  portEXIT_CRITICAL(&jsonCacheMux);
+  #endif
+  return found;
+}
+
+// serializes one cache entry per call, called from main loop
+void handleJsonCache()
+{
+  if (jsonCacheDirty) {
+    #ifdef ARDUINO_ARCH_ESP32
+    portENTER_CRITICAL(&jsonCacheMux);
+    #endif
+    std::vector<json_cache_entry_t> old;
+    old.swap(jsonCache); // free outside of critical section
+    jsonCacheDirty = false;
+    #ifdef ARDUINO_ARCH_ESP32
+    portEXIT_CRITICAL(&jsonCacheMux);
+    #endif
+    jsonCacheBuildIdx = 0;
+    return;
+  }
+  if (jsonCacheBuildIdx > JSON_CACHE_PAL && jsonCacheBuildIdx >= jsonCache.size()) return; // complete
+
+  JsonDocument *doc = requestJSONDocument(23);
+  if (!doc) return; // try again later
+  unsigned pages = 0;
+  switch (jsonCacheBuildIdx) {
+    case JSON_CACHE_EFF:    serializeModeNames(doc->to<JsonArray>()); break;
+    case JSON_CACHE_FXDATA: serializeModeData(doc->to<JsonArray>()); break;
+    default:
+      serializePalettes(doc->to<JsonObject>(), jsonCacheBuildIdx - JSON_CACHE_PAL);
+      pages = (*doc)["m"].as<unsigned>() + 1;
+      break;
+  }
+  json_cache_entry_t entry = {nullptr, 0};
+  if (!doc->overflowed()) {
+    HashPrint hash;
+    serializeJson(*doc, hash);
+    entry.hash = hash.hash() ? hash.hash() : 1; // 0 means unknown
+    #ifdef WLED_JSON_CACHE
+    JsonSnapshot *snap = new(std::nothrow) JsonSnapshot;
+    if (snap) {
+      snap->len  = measureJson(*doc);
+      snap->data = static_cast<char*>(p_malloc(snap->len + 1));
+      if (snap->data) serializeJson(*doc, snap->data, snap->len + 1);
+      else            snap->len = 0;
+      if (snap->len) entry.data.reset(snap);
+      else           delete snap;
+    }
+    #endif
+  }
+  releaseJSONDocument(doc);
+
+  // only the main loop modifies the cache, readers need a consistent vector (no allocation in critical section)
+  std::vector<json_cache_entry_t> next(jsonCache);
+  if (jsonCacheBuildIdx == JSON_CACHE_PAL) next.resize(JSON_CACHE_PAL + pages);
+  else if (jsonCacheBuildIdx >= next.size()) next.resize(jsonCacheBuildIdx + 1);
+  next[jsonCacheBuildIdx++] = entry;
+  #ifdef ARDUINO_ARCH_ESP32
+  portENTER_CRITICAL(&jsonCacheMux);
+  #endif
+  if (!jsonCacheDirty) jsonCache.swap(next); // unless invalidated meanwhile
+  #ifdef ARDUINO_ARCH_ESP32
+  portEXIT_CRITICAL(&jsonCacheMux);
+  #endif
+  DEBUG_PRINTF_P(PSTR("JSON cache entry %u: %08x (%u bytes).\n"), jsonCacheBuildIdx-1, entry.hash, entry.data ? entry.data->len : 0);
+}
+
+// answers 304 or sends cached response if possible, otherwise fills etag (if known) for the serialized response
+static bool serveJsonCache(AsyncWebServerRequest* request, unsigned idx, char *etag)
+{
+  etag[0] = '\0';
+  json_cache_entry_t entry;
+  if (!getJsonCacheEntry(idx, entry)) return false;
+  sprintf_P(etag, PSTR("\"%08x\""), entry.hash);
+  AsyncWebHeader *header = request->getHeader(F("If-None-Match"));
+  AsyncWebServerResponse *response;
+  if (header && header->value() == etag) response = request->beginResponse(304);
+  else if (entry.data)                   response = new JsonSnapshotResponse(entry.data); // no copy
+  else return false;
+  response->addHeader(F("Cache-Control"), F("no-cache")); // always revalidate
+  response->addHeader(F("ETag"), etag);
+  request->send(response);
+  return true;
+}
+
+/*
+ * MessagePack encoding of the JSON API (same model, smaller and faster to parse on small nodes)
+ * Responses are MessagePack if the Accept header asks for it, or if the request body was MessagePack.
+ */
+static const char CONTENT_TYPE_MSGPACK[] PROGMEM = "application/msgpack";
+
+bool isMsgPackBody(AsyncWebServerRequest* request)
+{
+  return request->contentType().indexOf(F("msgpack")) >= 0;
+}
+
+bool wantsMsgPack(AsyncWebServerRequest* request)
+{
+  AsyncWebHeader *accept = request->getHeader(F("Accept"));
+  if (accept) {
+    if (accept->value().indexOf(F("msgpack")) >= 0) return true;
+    if (accept->value().indexOf(F("json"))    >= 0) return false;
+  }
+  return isMsgPackBody(request); // reply in the format of the request
+}
+
+void serveJsonSuccess(AsyncWebServerRequest* request)
+{
+  static const uint8_t msgPackSuccess[] PROGMEM = {0x81, 0xA7, 's','u','c','c','e','s','s', 0xC3}; // {"success":true}
+  if (wantsMsgPack(request)) request->send_P(200, FPSTR(CONTENT_TYPE_MSGPACK), msgPackSuccess, sizeof(msgPackSuccess));
+  else                       request->send(200, CONTENT_TYPE_JSON, F("{\"success\":true}"));
+}
+
+// replace pre-serialized JSON (serialized()) by parsed values, MessagePack output would copy the JSON text verbatim
+static void parseRawJson(JsonObject obj, const char *key)
+{
+  JsonVariant v = obj[key];
+  if (v.isNull()) return;
+  size_t len = measureJson(v);
+  char *json = static_cast<char*>(malloc(len + 1));
+  if (!json) return;
+  serializeJson(v, json, len + 1);
+  DynamicJsonDocument tmp(2*len + 256);
+  if (deserializeJson(tmp, (const char*)json) == DeserializationError::Ok) obj[key] = tmp.as<JsonVariant>(); // strings are copied
+  free(json);
+}
+
+// make state (root or root["state"]) and "palettes" of a serialized JSON API response MessagePack compatible
+void prepareMsgPack(JsonVariant root)
+{
+  JsonObject state = root.containsKey("state") ? root["state"].as<JsonObject>() : root.as<JsonObject>();
+  if (state.isNull()) return;
+  for (JsonObject seg : state["seg"].as<JsonArray>()) parseRawJson(seg, "col");
+  parseRawJson(root.as<JsonObject>(), "palettes");
+}
+
 // Global buffer locking response helper class (to make sure lock is released when AsyncJsonResponse is destroyed)
 class LockedJsonResponse: public AsyncJsonResponse {
+  JsonDocument* _doc;
   bool _holding_lock;
+  bool _msgPack;
   public:
   // WARNING: constructor assumes requestJSONBufferLock() was successfully acquired externally/prior to constructing the instance
   // Not a good practice with C++. Unfortunately AsyncJsonResponse only has 2 constructors - for dynamic buffer or existing buffer,
   // with existing buffer it clears its content during construction
   // if the lock was not acquired (using JSONBufferGuard class) previous implementation still cleared existing buffer
-  inline LockedJsonResponse(JsonDocument* doc, bool isArray) : AsyncJsonResponse(doc, isArray), _holding_lock(true) {};
+  inline LockedJsonResponse(JsonDocument* doc, bool isArray, bool msgPack = false) : AsyncJsonResponse(doc, isArray), _doc(doc), _holding_lock(true), _msgPack(msgPack) {};
+
+  size_t setLength() {
+    size_t len = AsyncJsonResponse::setLength(); // also marks response valid
+    if (_msgPack) {
+      _contentType = FPSTR(CONTENT_TYPE_MSGPACK);
+      len = _contentLength = measureMsgPack(getRoot());
+    }
+    return len;
+  }
 
   virtual size_t _fillBuffer(uint8_t *buf, size_t maxLen) { 
-    size_t result = AsyncJsonResponse::_fillBuffer(buf, maxLen);
+    size_t result;
+    if (_msgPack) {
+      ChunkPrint dest(buf, _sentLength, maxLen);
+      serializeMsgPack(getRoot(), dest);
+      result = maxLen;
+    } else
+      result = AsyncJsonResponse::_fillBuffer(buf, maxLen);
     // Release lock as soon as we're done filling content
     if (((result + _sentLength) >= (_contentLength)) && _holding_lock) {
-      releaseJSONBufferLock();
+      releaseJSONDocument(_doc); // pool document or global buffer lock
       _holding_lock = false;
     }
     return result;
   }
 
   // destructor will remove JSON buffer lock when response is destroyed in AsyncWebServer
-  virtual ~LockedJsonResponse() { if (_holding_lock) releaseJSONBufferLock(); };
+  virtual ~LockedJsonResponse() { if (_holding_lock) releaseJSONDocument(_doc); };
 };
 
 void serveJson(AsyncWebServerRequest* request)
 {
+  PerfScope perf(PERF_JSON);
+  TraceScope trace(TRACE_JSON);
   enum class json_target {
-    all, state, info, state_info, nodes, effects, palettes, fxdata, networks, config
+    all, state, info, state_info, nodes, effects, palettes, fxdata, networks, config, perf
   };
   json_target subJson = json_target::all;
 
@@ -1114,6 +1881,11 @@ void serveJson(AsyncWebServerRequest* request)
   else if (url.indexOf(F("fxda"))  > 0) subJson = json_target::fxdata;
   else if (url.indexOf(F("net"))   > 0) subJson = json_target::networks;
   else if (url.indexOf(F("cfg"))   > 0) subJson = json_target::config;
+  else if (url.indexOf(F("perf"))  > 0) subJson = json_target::perf;
+  else if (url.indexOf(F("trace")) > 0) {
+    serveTrace(request);
+    return;
+  }
   #ifdef WLED_ENABLE_JSONLIVE
   else if (url.indexOf("live")     > 0) {
     serveLiveLeds(request);
@@ -1129,13 +1901,49 @@ void serveJson(AsyncWebServerRequest* request)
     return;
   }
 
-  if (!requestJSONBufferLock(17)) {
+  const bool msgPack = wantsMsgPack(request); // snapshots and streaming are JSON only
+  if (!msgPack && (subJson == json_target::state || subJson == json_target::state_info) && serveJsonSnapshot(request, subJson == json_target::state_info)) return;
+  if (!msgPack && (subJson == json_target::state || subJson == json_target::info || subJson == json_target::state_info)) {
+    // stream in chunks without building the whole DOM, the lock keeps segments unchanged until the response is complete
+    if (!requestJSONBufferLock(17)) {
+      request->deferResponse();
+      return;
+    }
+    const bool state = subJson != json_target::info;
+    const bool info  = subJson != json_target::state;
+    std::shared_ptr<JsonChunkSource> source;
+    if (measureStreamJson(state, info)) source.reset(new(std::nothrow) JsonChunkSource(state, info)); // all pieces fit the small document
+    if (source && !source->failed()) {
+      source->takeLock();
+      request->send(request->beginChunkedResponse(FPSTR(CONTENT_TYPE_JSON), [source](uint8_t *buf, size_t maxLen, size_t) -> size_t {
+        return source->fill(buf, maxLen);
+      }));
+      return;
+    }
+    releaseJSONBufferLock(); // fall back to DOM
+  }
+
+  char etag[12] = "";
+  if (!msgPack) {
+    int page = request->hasParam(F("page")) ? request->getParam(F("page"))->value().toInt() : 0;
+    int idx = -1;
+    if      (subJson == json_target::effects)  idx = JSON_CACHE_EFF;
+    else if (subJson == json_target::fxdata)   idx = JSON_CACHE_FXDATA;
+    else if (subJson == json_target::palettes && page >= 0) idx = JSON_CACHE_PAL + page;
+    if (idx >= 0 && serveJsonCache(request, idx, etag)) return;
+  }
+
+  // state, info, nodes and config may be changed by a writer holding the global buffer, only static data may use a pool document
+  const bool staticData = subJson == json_target::effects || subJson == json_target::palettes || subJson == json_target::fxdata
+                       || subJson == json_target::networks || subJson == json_target::perf;
+  JsonDocument *doc = staticData ? requestJSONDocument(17) : (requestJSONBufferLock(17) ? pDoc : nullptr);
+  if (!doc) {
     request->deferResponse();    
     return;
   }
-  // releaseJSONBufferLock() will be called when "response" is destroyed (from AsyncWebServer)
+  // releaseJSONDocument() will be called when "response" is destroyed (from AsyncWebServer)
   // make sure you delete "response" if no "request->send(response);" is made
-  LockedJsonResponse *response = new LockedJsonResponse(pDoc, subJson==json_target::fxdata || subJson==json_target::effects); // will clear and convert JsonDocument into JsonArray if necessary
+  LockedJsonResponse *response = new LockedJsonResponse(doc, subJson==json_target::fxdata || subJson==json_target::effects, msgPack); // will clear and convert JsonDocument into JsonArray if necessary
 
   JsonVariant lDoc = response->getRoot();
 
@@ -1157,6 +1965,10 @@ void serveJson(AsyncWebServerRequest* request)
       serializeNetworks(lDoc); break;
     case json_target::config:
       serializeConfig(lDoc); break;
+    case json_target::perf:
+      serializePerf(lDoc);
+      if (request->hasParam(F("reset"))) perfReset();
+      break;
     case json_target::state_info:
     case json_target::all:
       JsonObject state = lDoc.createNestedObject("state");
@@ -1172,10 +1984,15 @@ void serveJson(AsyncWebServerRequest* request)
       //lDoc["m"] = lDoc.memoryUsage(); // JSON buffer usage, for remote debugging
   }
 
+  if (msgPack) prepareMsgPack(lDoc);
   DEBUG_PRINTF_P(PSTR("JSON buffer size: %u for request: %d\n"), lDoc.memoryUsage(), subJson);
 
   [[maybe_unused]] size_t len = response->setLength();
   DEBUG_PRINTF_P(PSTR("JSON content length: %u\n"), len);
+  if (etag[0]) { // cached hash of this response (not cached content)
+    response->addHeader(F("Cache-Control"), F("no-cache"));
+    response->addHeader(F("ETag"), etag);
+  }
 
   request->send(response);
 }
@@ -88,18 +88,19 @@ void stateUpdated(byte callMode) {
   //call for notifier -> 0: init 1: direct change 2: button 3: notification 4: nightlight 5: other (No notification)
   //                     6: fx changed 7: hue 8: preset cycle 9: blynk 10: alexa 11: ws send only 12: button preset
   setValuesFromFirstSelectedSeg();  // a much better approach would be to use main segment: setValuesFromMainSeg()
+  stateGeneration++;
 
   if (bri != briOld || stateChanged) {
     if (stateChanged) currentPreset = 0; //something changed, so we are no longer in the preset
 
-    if (callMode != CALL_MODE_NOTIFICATION && callMode != CALL_MODE_NO_NOTIFY) notify(callMode);
-    if (bri != briOld && nodeBroadcastEnabled) sendSysInfoUDP(); // update on state
+    if (callMode != CALL_MODE_NOTIFICATION && callMode != CALL_MODE_NO_NOTIFY) scheduleNotify(callMode);
+    if (bri != briOld && nodeBroadcastEnabled) scheduleSysInfoUDP(); // update on state
 
     //set flag to update ws and mqtt
     interfaceUpdateCallMode = callMode;
   } else {
     if (nightlightActive && !nightlightActiveOld && callMode != CALL_MODE_NOTIFICATION && callMode != CALL_MODE_NO_NOTIFY) {
-      notify(CALL_MODE_NIGHTLIGHT);
+      scheduleNotify(CALL_MODE_NIGHTLIGHT);
       interfaceUpdateCallMode = CALL_MODE_NIGHTLIGHT;
     }
   }
@@ -142,6 +143,7 @@ void stateUpdated(byte callMode) {
 void updateInterfaces(uint8_t callMode) {
   if (!interfaceUpdateCallMode || millis() - lastInterfaceUpdate < INTERFACE_UPDATE_COOLDOWN) return;
 
+  stateGeneration++; // WS update may be requested without stateUpdated()
   sendDataWs();
   lastInterfaceUpdate = millis();
   interfaceUpdateCallMode = CALL_MODE_INIT; //disable further updates
@@ -161,6 +163,12 @@ void updateInterfaces(uint8_t callMode) {
 
 
 void handleTransitions() {
+  // state changed by fast JSON updates since last loop (coalesced into one update)
+  if (stateUpdatePending) {
+    stateUpdatePending = false;
+    stateUpdated(CALL_MODE_DIRECT_CHANGE);
+  }
+
   //handle still pending interface update
   updateInterfaces(interfaceUpdateCallMode);
 
@@ -13,6 +13,14 @@
 
 static const char* sTopicFormat PROGMEM = "%.*s/%s";
 
+// last published state, only changed topics are published again (valid == false publishes all)
+static struct {
+  bool     valid;
+  uint8_t  bri;
+  uint32_t col;
+  uint32_t xmlHash;
+} mqttPublished = {false, 0, 0, 0};
+
 // parse payload for brightness, ON/OFF or toggle
 // briLast is used to remember last brightness value in case of ON/OFF or toggle
 // bri is set to 0 if payload is "0" or "OFF" or "false"
@@ -59,6 +67,7 @@ static void onMqttConnect(bool sessionPresent)
   mqtt->publish(subuf, 0, true, "online"); // retain message for a LWT
 #endif
 
+  mqttPublished.valid = false; // (re)publish all topics
   publishMqtt();
 }
 
@@ -170,24 +179,39 @@ void publishMqtt()
   #ifndef USERMOD_SMARTNEST
   char s[10];
   char subuf[MQTT_MAX_TOPIC_LEN + 16];
+  const bool all = !mqttPublished.valid;
 
-  sprintf_P(s, PSTR("%u"), bri);
-  snprintf_P(subuf, sizeof(subuf)-1, sTopicFormat, MQTT_MAX_TOPIC_LEN, mqttDeviceTopic, "g");
-  mqtt->publish(subuf, 0, retainMqttMsg, s);         // optionally retain message (#2263)
+  if (all || bri != mqttPublished.bri) {
+    sprintf_P(s, PSTR("%u"), bri);
+    snprintf_P(subuf, sizeof(subuf)-1, sTopicFormat, MQTT_MAX_TOPIC_LEN, mqttDeviceTopic, "g");
+    mqtt->publish(subuf, 0, retainMqttMsg, s);         // optionally retain message (#2263)
+    mqttPublished.bri = bri;
+  }
 
-  sprintf_P(s, PSTR("#%06X"), (colPri[3] << 24) | (colPri[0] << 16) | (colPri[1] << 8) | (colPri[2]));
-  snprintf_P(subuf, sizeof(subuf)-1, sTopicFormat, MQTT_MAX_TOPIC_LEN, mqttDeviceTopic, "c");
-  mqtt->publish(subuf, 0, retainMqttMsg, s);         // optionally retain message (#2263)
+  uint32_t col = (colPri[3] << 24) | (colPri[0] << 16) | (colPri[1] << 8) | (colPri[2]);
+  if (all || col != mqttPublished.col) {
+    sprintf_P(s, PSTR("#%06X"), col);
+    snprintf_P(subuf, sizeof(subuf)-1, sTopicFormat, MQTT_MAX_TOPIC_LEN, mqttDeviceTopic, "c");
+    mqtt->publish(subuf, 0, retainMqttMsg, s);         // optionally retain message (#2263)
+    mqttPublished.col = col;
+  }
 
-  snprintf_P(subuf, sizeof(subuf)-1, sTopicFormat, MQTT_MAX_TOPIC_LEN, mqttDeviceTopic, "status");
-  mqtt->publish(subuf, 0, true, "online");  // retain message for a LWT
+  if (all) {
+    snprintf_P(subuf, sizeof(subuf)-1, sTopicFormat, MQTT_MAX_TOPIC_LEN, mqttDeviceTopic, "status");
+    mqtt->publish(subuf, 0, true, "online");  // retain message for a LWT
+  }
 
   // TODO: use a DynamicBufferList.  Requires a list-read-capable MQTT client API.
   DynamicBuffer buf(1024);
   bufferPrint pbuf(buf.data(), buf.size());
   XML_response(pbuf);
-  snprintf_P(subuf, sizeof(subuf)-1, sTopicFormat, MQTT_MAX_TOPIC_LEN, mqttDeviceTopic, "v");
-  mqtt->publish(subuf, 0, retainMqttMsg, buf.data(), pbuf.size());   // optionally retain message (#2263)
+  uint32_t xmlHash = hashBuffer(reinterpret_cast<const uint8_t*>(buf.data()), pbuf.size());
+  if (all || xmlHash != mqttPublished.xmlHash) {
+    snprintf_P(subuf, sizeof(subuf)-1, sTopicFormat, MQTT_MAX_TOPIC_LEN, mqttDeviceTopic, "v");
+    mqtt->publish(subuf, 0, retainMqttMsg, buf.data(), pbuf.size());   // optionally retain message (#2263)
+    mqttPublished.xmlHash = xmlHash;
+  }
+  mqttPublished.valid = true;
   #endif
 }
 
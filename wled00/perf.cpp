@@ -0,0 +1,158 @@
+#include "wled.h"
+
+/*
+ * Loop and frame profiler (always enabled, see /json/perf)
+ * keeps count, min, avg, max and a histogram (for p99) of microsecond timings
+ * per main loop stage, for async web/WebSocket handlers, per segment effect function and per usermod loop()
+ * and the duration of the boot phases (see /json/info)
+ */
+
+#define PERF_BUCKETS 40 // 2 buckets per octave: 0-1us, 2us, 3us, 4-5us, 6-7us, 8-11us ... (last one open ended, ~1s)
+
+typedef struct PerfStats {
+  uint32_t count;
+  uint32_t min;
+  uint32_t max;
+  uint64_t sum;
+  uint8_t  hist[PERF_BUCKETS]; // halved when a bucket is full, so recent timings weigh more
+} perf_stats_t;
+
+static const char perfStageNames[PERF_STAGE_COUNT][8] PROGMEM = {
+  "loop", "notify", "usermod", "io", "strip", "show", "bus", "ws", "json", "wsevent", "jobs"
+};
+
+static const char bootPhaseNames[BOOT_PHASE_COUNT][7] PROGMEM = {
+  "init", "fs", "cfg", "bus", "pal", "ledmap", "strip", "um", "net", "server", "setup", "frame", "conn"
+};
+
+static perf_stats_t  perfStages[PERF_STAGE_COUNT];
+static perf_stats_t *perfEffects = nullptr; // per segment, allocated on first use
+static perf_stats_t *perfUsermods = nullptr; // per usermod, allocated on first use
+static unsigned long perfResetTime = 0;
+static uint32_t      bootTimes[BOOT_PHASE_COUNT]; // end of phase (micros()) or milestone (millis()), 0: not reached yet
+
+static inline unsigned perfBucket(uint32_t us) {
+  if (us < 2) return 0;
+  unsigned msb = 31 - __builtin_clz(us);
+  unsigned b = 2*msb + ((us >> (msb-1)) & 1) - 1;
+  return b < PERF_BUCKETS ? b : PERF_BUCKETS-1;
+}
+
+// lowest timing (us) of histogram bucket
+static uint32_t perfBucketLow(unsigned b) {
+  if (b == 0) return 0;
+  unsigned msb = (b+1) / 2;
+  return (1UL << msb) + ((b+1) % 2) * (1UL << (msb-1));
+}
+
+static void perfAdd(perf_stats_t &s, uint32_t us) {
+  if (!s.count || us < s.min) s.min = us;
+  if (us > s.max) s.max = us;
+  s.count++;
+  s.sum += us;
+  unsigned b = perfBucket(us);
+  if (s.hist[b] == UINT8_MAX) for (unsigned i = 0; i < PERF_BUCKETS; i++) s.hist[i] >>= 1;
+  s.hist[b]++;
+}
+
+// start is micros() taken at the beginning of the stage
+void perfRecord(uint8_t stage, unsigned long start) {
+  if (stage < PERF_STAGE_COUNT) perfAdd(perfStages[stage], micros() - start);
+}
+
+void perfRecordEffect(unsigned segment, unsigned long start) {
+  uint32_t us = micros() - start;
+  if (segment >= strip.getMaxSegments()) return;
+  if (!perfEffects) {
+    perfEffects = static_cast<perf_stats_t*>(d_calloc(strip.getMaxSegments(), sizeof(perf_stats_t)));
+    if (!perfEffects) return;
+  }
+  perfAdd(perfEffects[segment], us);
+}
+
+void perfRecordUsermod(unsigned index, unsigned long start) {
+  uint32_t us = micros() - start;
+  if (index >= UsermodManager::getModCount()) return;
+  if (!perfUsermods) {
+    perfUsermods = static_cast<perf_stats_t*>(d_calloc(UsermodManager::getModCount(), sizeof(perf_stats_t)));
+    if (!perfUsermods) return;
+  }
+  perfAdd(perfUsermods[index], us);
+}
+
+void perfReset() {
+  memset(perfStages, 0, sizeof(perfStages));
+  if (perfEffects) memset(perfEffects, 0, strip.getMaxSegments() * sizeof(perf_stats_t));
+  if (perfUsermods) memset(perfUsermods, 0, UsermodManager::getModCount() * sizeof(perf_stats_t));
+  resetJobStats();
+  perfResetTime = millis();
+}
+
+// upper bound of the bucket containing the 99th percentile (limited by max)
+static uint32_t perfP99(const perf_stats_t &s) {
+  unsigned total = 0;
+  for (unsigned i = 0; i < PERF_BUCKETS; i++) total += s.hist[i];
+  if (!total) return 0;
+  unsigned target = total - total / 100, sum = 0;
+  for (unsigned i = 0; i < PERF_BUCKETS-1; i++) {
+    sum += s.hist[i];
+    if (sum >= target) return min(perfBucketLow(i+1) - 1, s.max);
+  }
+  return s.max;
+}
+
+static void serializePerfStats(JsonObject obj, const perf_stats_t &s) {
+  obj["n"]       = s.count;
+  obj[F("min")]  = s.min;
+  obj[F("avg")]  = s.count ? (uint32_t)(s.sum / s.count) : 0;
+  obj[F("p99")]  = perfP99(s);
+  obj[F("max")]  = s.max;
+}
+
+void serializePerf(JsonObject root) {
+  root[F("time")] = (millis() - perfResetTime) / 1000; // seconds since statistics were reset
+  root[F("fps")]  = strip.getFps();
+  JsonObject stages = root.createNestedObject(F("stages")); // all timings in us
+  for (unsigned i = 0; i < PERF_STAGE_COUNT; i++) {
+    if (!perfStages[i].count) continue;
+    char name[8];
+    strcpy_P(name, perfStageNames[i]);
+    serializePerfStats(stages.createNestedObject(name), perfStages[i]); // name is copied
+  }
+  JsonArray segs = root.createNestedArray(F("seg"));
+  for (unsigned i = 0; perfEffects && i < strip.getMaxSegments(); i++) {
+    if (!perfEffects[i].count) continue;
+    JsonObject seg = segs.createNestedObject();
+    seg["id"] = i;
+    if (i < strip.getSegmentsNum()) seg["fx"] = strip.getSegment(i).mode;
+    serializePerfStats(seg, perfEffects[i]);
+  }
+  serializeJobs(root.createNestedArray(F("jobs")));
+  JsonArray ums = root.createNestedArray(F("um")); // loop() timing, id is the usermod ID
+  for (unsigned i = 0; perfUsermods && i < UsermodManager::getModCount(); i++) {
+    if (!perfUsermods[i].count) continue;
+    JsonObject um = ums.createNestedObject();
+    um["id"] = UsermodManager::getMod(i)->getId();
+    serializePerfStats(um, perfUsermods[i]);
+  }
+}
+
+// marks the end of a boot phase or reaching a milestone, only the first call per phase counts (i.e. finalizeInit() is called again on bus changes)
+void bootPhase(uint8_t phase) {
+  if (phase >= BOOT_PHASE_COUNT || bootTimes[phase]) return;
+  bootTimes[phase] = max(1UL, phase < BOOT_FRAME ? micros() : millis());
+}
+
+// phase durations in us, milestones in ms since power-on
+void serializeBootTimes(JsonObject root) {
+  uint32_t last = 0;
+  for (unsigned i = 0; i < BOOT_PHASE_COUNT; i++) {
+    if (!bootTimes[i]) continue;
+    char name[7];
+    strcpy_P(name, bootPhaseNames[i]);
+    if (i < BOOT_FRAME) {
+      root[name] = bootTimes[i] - last; // name is copied
+      last = bootTimes[i];
+    } else root[name] = bootTimes[i];
+  }
+}
@@ -18,6 +18,8 @@ static PlaylistEntry *playlistEntries = nullptr;
 static byte           playlistLen;               //number of playlist entries
 static int8_t         playlistIndex = -1;
 static uint16_t       playlistEntryDur = 0;      //duration of the current entry in tenths of seconds
+static bool           playlistPrefetched = false; //next entry has been prefetched
+static bool           playlistShuffled = false;   //playlist was shuffled ahead of roll-over for prefetch
 
 //values we need to keep about the parent playlist while inside sub-playlist
 static int16_t        parentPlaylistIndex = -1;
@@ -49,6 +51,7 @@ void unloadPlaylist() {
   }
   currentPlaylist = playlistIndex = -1;
   playlistLen = playlistEntryDur = playlistOptions = 0;
+  playlistPrefetched = playlistShuffled = false;
   DEBUG_PRINTLN(F("Playlist unloaded."));
 }
 
@@ -142,12 +145,35 @@ int16_t loadPlaylist(JsonObject playlistObj, byte presetId) {
 }
 
 
+// returns the preset that will be applied when the current entry ends (0 if none)
+// shuffles the playlist ahead of roll-over so the prefetched entry is the one that is applied
+static byte getNextPlaylistPreset() {
+  int nextIndex = (playlistIndex + 1) % playlistLen;
+  if (nextIndex == 0) {
+    if (playlistRepeat == 1) return parentPlaylistPresetId > 0 ? parentPlaylistPresetId : playlistEndPreset;
+    if ((playlistOptions & PL_OPTION_SHUFFLE) && !playlistShuffled) {
+      shufflePlaylist();
+      playlistShuffled = true;
+    }
+  }
+  return playlistEntries[nextIndex].preset;
+}
+
 void handlePlaylist() {
   static unsigned long presetCycledTime = 0;
   if (currentPlaylist < 0 || playlistEntries == nullptr) return;
 
+  // load and parse next entry ahead of time so the switch only needs to apply it
+  if (!playlistPrefetched && playlistIndex >= 0 && playlistEntryDur < UINT16_MAX && bri && !nightlightActive
+      && millis() - presetCycledTime + PLAYLIST_PREFETCH_TIME > 100UL * playlistEntryDur) {
+    playlistPrefetched = true;
+    byte next = getNextPlaylistPreset();
+    if (next) prefetchPreset(next);
+  }
+
   if ((playlistEntryDur < UINT16_MAX && millis() - presetCycledTime > 100 * playlistEntryDur) || doAdvancePlaylist) {
     presetCycledTime = millis();
+    playlistPrefetched = false;
     if (bri == 0 || nightlightActive) return;
 
     ++playlistIndex %= playlistLen; // -1 at 1st run (limit to playlistLen)
@@ -164,7 +190,8 @@ void handlePlaylist() {
       }
       if (playlistRepeat > 1) playlistRepeat--; // decrease repeat count on each index reset if not an endless playlist
       // playlistRepeat == 0: endless loop
-      if (playlistOptions & PL_OPTION_SHUFFLE) shufflePlaylist(); // shuffle playlist and start over
+      if ((playlistOptions & PL_OPTION_SHUFFLE) && !playlistShuffled) shufflePlaylist(); // shuffle playlist and start over
+      playlistShuffled = false;
     }
 
     jsonTransitionOnce = true;
@@ -6,6 +6,78 @@
 
 #ifdef ARDUINO_ARCH_ESP32
 static char *tmpRAMbuffer = nullptr;
+
+/*
+ * Pre-parsed preset cache: presets are kept as MessagePack in (PS)RAM so applying them needs
+ * no file system access and no JSON text parsing. Filled in the background after boot,
+ * updated when presets are saved or deleted and flushed when files are uploaded.
+ */
+#ifndef WLED_PRESET_CACHE_SIZE
+  #define WLED_PRESET_CACHE_SIZE (psramFound() ? 131072 : 16384) // max. bytes used by cached presets
+#endif
+
+typedef struct PresetCacheEntry {
+  uint8_t *data;
+  uint16_t len;
+  uint8_t  id;
+} preset_cache_entry_t;
+
+static std::vector<preset_cache_entry_t> presetCache;
+static size_t presetCacheSize = 0;
+static byte presetCacheValidate = 0;
+static uint8_t presetCacheFill = 1; // next preset to load in background, 0 when done
+
+static void uncachePreset(uint8_t id) {
+  for (auto it = presetCache.begin(); it != presetCache.end(); ++it) {
+    if (it->id == id) {
+      presetCacheSize -= it->len;
+      p_free(it->data);
+      presetCache.erase(it);
+      return;
+    }
+  }
+}
+
+static void checkPresetCache() {
+  if (presetCacheValidate == cacheInvalidate) return;
+  for (auto &e : presetCache) p_free(e.data);
+  presetCache.clear();
+  presetCacheSize = 0;
+  presetCacheValidate = cacheInvalidate;
+  presetCacheFill = 1; // presets.json may have been uploaded, reload
+}
+
+static void cachePreset(uint8_t id, const JsonDocument *doc) {
+  uncachePreset(id);
+  if (doc->isNull()) return;
+  size_t len = measureMsgPack(*doc);
+  if (len > UINT16_MAX || presetCacheSize + len > WLED_PRESET_CACHE_SIZE) return;
+  uint8_t *data = static_cast<uint8_t*>(allocate_buffer(len, BFRALLOC_PREFER_PSRAM));
+  if (!data) return;
+  serializeMsgPack(*doc, data, len);
+  presetCache.push_back({data, (uint16_t)len, id});
+  presetCacheSize += len;
+}
+
+static bool loadCachedPreset(uint8_t id, JsonDocument *doc) {
+  checkPresetCache();
+  for (const auto &e : presetCache) {
+    if (e.id == id) return deserializeMsgPack(*doc, (const uint8_t*)e.data, e.len) == DeserializationError::Ok; // const: copy strings, keep the cached blob intact
+  }
+  return false;
+}
+
+// load one preset into cache per call while idle
+static void fillPresetCache() {
+  checkPresetCache();
+  if (!presetCacheFill || jsonBufferLock || strip.isUpdating() || !requestJSONBufferLock(9)) return;
+  if (readObjectFromFileUsingId(getPresetsFileName(), presetCacheFill, pDoc)) cachePreset(presetCacheFill, pDoc);
+  releaseJSONBufferLock();
+  if (++presetCacheFill > 250) {
+    presetCacheFill = 0;
+    DEBUG_PRINTF_P(PSTR("Preset cache: %u presets, %u bytes.\n"), presetCache.size(), presetCacheSize);
+  }
+}
 #endif
 
 static volatile byte presetToApply = 0;
@@ -14,6 +86,10 @@ static volatile byte presetToSave = 0;
 static volatile int8_t saveLedmap = -1;
 static char *quickLoad = nullptr;
 static char *saveName = nullptr;
+static uint8_t *stagedPreset = nullptr; // prefetched preset (MessagePack), see prefetchPreset()
+static size_t stagedLen = 0;
+static byte stagedId = 0;
+static byte stagedValidate = 0;
 static bool includeBri = true, segBounds = true, selectedOnly = false, playlistSave = false;;
 
 static const char presets_json[] PROGMEM = "/presets.json";
@@ -26,6 +102,12 @@ bool presetNeedsSaving() {
   return presetToSave;
 }
 
+static void clearStagedPreset() {
+  p_free(stagedPreset);
+  stagedPreset = nullptr;
+  stagedLen = stagedId = 0;
+}
+
 static void doSaveState() {
   bool persist = (presetToSave < 251);
 
@@ -70,6 +152,10 @@ static void doSaveState() {
   #endif
   writeObjectToFileUsingId(getPresetsFileName(persist), presetToSave, pDoc);
 
+  if (presetToSave == stagedId) clearStagedPreset();
+  #ifdef ARDUINO_ARCH_ESP32
+  if (persist) cachePreset(presetToSave, pDoc);
+  #endif
   if (persist) presetsModifiedTime = toki.second(); //unix time
   releaseJSONBufferLock();
   updateFSInfo();
@@ -84,6 +170,28 @@ static void doSaveState() {
   playlistSave = false;
 }
 
+// load preset ahead of time (i.e. next playlist entry) so that applying it needs no file system access or JSON parsing
+void prefetchPreset(byte index) {
+  if (index == 0 || index > 250 || index == stagedId) return;
+  #ifdef ARDUINO_ARCH_ESP32
+  checkPresetCache();
+  for (const auto &e : presetCache) if (e.id == index) return; // already pre-parsed
+  #endif
+  if (jsonBufferLock || !requestJSONBufferLock(9)) return; // do not wait, will be loaded when applied
+  clearStagedPreset();
+  if (readObjectFromFileUsingId(getPresetsFileName(), index, pDoc)) {
+    size_t len = measureMsgPack(*pDoc);
+    stagedPreset = static_cast<uint8_t*>(p_malloc(len));
+    if (stagedPreset) {
+      stagedLen = serializeMsgPack(*pDoc, stagedPreset, len);
+      stagedId = index;
+      stagedValidate = cacheInvalidate;
+      DEBUG_PRINTF_P(PSTR("Prefetched preset %u (%u bytes).\n"), index, stagedLen);
+    }
+  }
+  releaseJSONBufferLock();
+}
+
 bool getPresetName(byte index, String& name)
 {
   if (!requestJSONBufferLock(19)) return false;
@@ -99,10 +207,29 @@ bool getPresetName(byte index, String& name)
   return presetExists;
 }
 
+// passes a preset to usermods only (fast start applies the boot preset before usermods are set up and they ignore it)
+void applyPresetToUsermods(byte index)
+{
+  if (!requestJSONBufferLock(26)) return;
+  bool loaded = false;
+  #ifdef ARDUINO_ARCH_ESP32
+  loaded = loadCachedPreset(index, pDoc);
+  #endif
+  if (!loaded) loaded = readObjectFromFileUsingId(getPresetsFileName(), index, pDoc);
+  if (loaded && pDoc->is<JsonObject>()) {
+    JsonObject fdo = pDoc->as<JsonObject>();
+    if (fdo["win"].isNull()) UsermodManager::readFromJsonState(fdo); // HTTP API presets do not carry usermod state
+  }
+  releaseJSONBufferLock();
+}
+
 void initPresetsFile()
 {
   char fileName[33]; strncpy_P(fileName, getPresetsFileName(), 32); fileName[32] = 0; //use PROGMEM safe copy as FS.open() does not
   if (WLED_FS.exists(fileName)) return;
+  #ifdef WLED_ENABLE_PRESET_LOG
+  if (restorePresetLogSnapshot()) return; // compaction was interrupted
+  #endif
 
   StaticJsonDocument<64> doc;
   JsonObject sObj = doc.to<JsonObject>();
@@ -146,13 +273,18 @@ void handlePresets()
 {
   byte presetErrFlag = ERR_NONE;
   if (presetToSave) {
+    TraceScope trace(TRACE_PRESET_SAVE, presetToSave);
     strip.suspend();
     doSaveState();
     strip.resume();
     return;
   }
 
+  #ifdef ARDUINO_ARCH_ESP32
+  if (presetToApply == 0) fillPresetCache();
+  #endif
   if (presetToApply == 0 || !requestJSONBufferLock(9)) return; // no preset waiting to apply, or JSON buffer is already allocated, return to loop until free
+  TraceScope trace(TRACE_PRESET_APPLY, presetToApply);
 
   bool changePreset = false;
   uint8_t tmpPreset = presetToApply; // store temporary since deserializeState() may call applyPreset()
@@ -173,10 +305,18 @@ void handlePresets()
   #ifdef ARDUINO_ARCH_ESP32
   if (tmpPreset==255 && tmpRAMbuffer!=nullptr) {
     deserializeJson(*pDoc,tmpRAMbuffer);
+  } else if (tmpPreset < 255 && loadCachedPreset(tmpPreset, pDoc)) {
+    DEBUG_PRINTLN(F("Preset from cache."));
   } else
   #endif
-  {
+  if (tmpPreset == stagedId && stagedValidate == cacheInvalidate && deserializeMsgPack(*pDoc, (const uint8_t*)stagedPreset, stagedLen) == DeserializationError::Ok) { // const: copy strings, buffer is freed below
+    DEBUG_PRINTLN(F("Preset from prefetch."));
+    clearStagedPreset();
+  } else {
   presetErrFlag = readObjectFromFileUsingId(getPresetsFileName(tmpPreset < 255), tmpPreset, pDoc) ? ERR_NONE : ERR_FS_PLOAD;
+  #ifdef ARDUINO_ARCH_ESP32
+  if (presetErrFlag == ERR_NONE && tmpPreset < 255) cachePreset(tmpPreset, pDoc); // before deserializeState() modifies it
+  #endif
   }
   fdo = pDoc->as<JsonObject>();
 
@@ -209,7 +349,7 @@ void handlePresets()
   #endif
 
   releaseJSONBufferLock();
-  if (changePreset) notify(tmpMode); // force UDP notification
+  if (changePreset) scheduleNotify(tmpMode, true); // force UDP notification
   stateUpdated(tmpMode);  // was colorUpdated() if anything breaks
   updateInterfaces(tmpMode);
 }
@@ -261,6 +401,10 @@ void savePreset(byte index, const char* pname, JsonObject sObj)
         if (sObj["n"].isNull()) sObj["n"] = saveName;
         initPresetsFile(); // just in case if someone deleted presets.json using /edit
         writeObjectToFileUsingId(getPresetsFileName(), index, pDoc);
+        if (index == stagedId) clearStagedPreset();
+        #ifdef ARDUINO_ARCH_ESP32
+        cachePreset(index, pDoc);
+        #endif
         presetsModifiedTime = toki.second(); //unix time
         updateFSInfo();
       }
@@ -280,6 +424,10 @@ void savePreset(byte index, const char* pname, JsonObject sObj)
 void deletePreset(byte index) {
   StaticJsonDocument<24> empty;
   writeObjectToFileUsingId(getPresetsFileName(), index, &empty);
+  if (index == stagedId) clearStagedPreset();
+  #ifdef ARDUINO_ARCH_ESP32
+  uncachePreset(index);
+  #endif
   presetsModifiedTime = toki.second(); //unix time
   updateFSInfo();
 }
\ No newline at end of file
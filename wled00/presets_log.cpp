@@ -0,0 +1,271 @@
+#include "wled.h"
+
+/*
+ * Log-structured preset store (optional, enable with -D WLED_ENABLE_PRESET_LOG)
+ *
+ * Saving or deleting a preset appends a record to /presets.log instead of patching presets.json in place.
+ * An index in RAM points at the latest record of every preset in the log; presets without a log record are
+ * read from presets.json. When no preset was saved for a while, the log is merged into presets.json
+ * (compaction) in small steps from the main loop, so presets.json stays a complete, compatible export
+ * for the UI, backups and downgrades. If presets.json is requested while the log is not merged yet, the request
+ * is deferred and compaction starts right away (see presetLogMergePending()).
+ *
+ * Record format: id (uint16 LE), length (uint16 LE), JSON object (length bytes). Length 0 marks a deleted preset.
+ */
+#ifdef WLED_ENABLE_PRESET_LOG
+
+#ifndef PRESET_LOG_COMPACT_DELAY
+  #define PRESET_LOG_COMPACT_DELAY 10000 // ms without preset saves before compaction starts
+#endif
+#define PRESET_LOG_CHUNK 512             // bytes processed per compaction step
+
+static const char presets_log[] PROGMEM = "/presets.log";
+static const char presets_tmp[] PROGMEM = "/presets.json.tmp";
+
+typedef struct PresetLogEntry {
+  uint32_t pos;   // file position of JSON data
+  uint16_t len;   // 0 if deleted
+  uint16_t id;
+} preset_log_entry_t;
+
+static std::vector<preset_log_entry_t> logIndex;
+static unsigned long lastLogWrite = 0;
+static volatile bool logPending = false;     // log has records not merged into presets.json
+static volatile bool compactRequested = false; // presets.json was requested, compact without waiting
+static bool compactFailed = false;           // presets.json could not be replaced, retry after reboot
+
+// compaction state
+static enum : uint8_t { COMPACT_IDLE, COMPACT_COPY, COMPACT_APPEND, COMPACT_FINISH } compactState = COMPACT_IDLE;
+static File cIn, cOut;
+static size_t   cAppendIdx = 0;
+static byte     cValidate = 0;
+static unsigned cDepth = 0;
+static bool     cInString = false, cEscaped = false, cInKey = false, cCopy = false, cFirst = true;
+static int      cKey = -1;
+
+static preset_log_entry_t *findLogEntry(unsigned id) {
+  for (auto &e : logIndex) if (e.id == id) return &e;
+  return nullptr;
+}
+
+static void abortCompaction() {
+  if (compactState == COMPACT_IDLE) return;
+  DEBUG_PRINTLN(F("Preset log compaction aborted."));
+  cIn.close();
+  cOut.close();
+  WLED_FS.remove(FPSTR(presets_tmp));
+  compactState = COMPACT_IDLE;
+}
+
+// returns 1 if preset was read from log, 0 if it was deleted and -1 if the log has no record for it
+int presetLogRead(uint16_t id, JsonDocument* dest, const JsonDocument* filter) {
+  const preset_log_entry_t *e = findLogEntry(id);
+  if (!e) return -1;
+  dest->clear();
+  if (!e->len) return 0;
+  File f = WLED_FS.open(FPSTR(presets_log), "r");
+  if (!f || !f.seek(e->pos)) return 0;
+  if (filter) deserializeJson(*dest, f, DeserializationOption::Filter(*filter));
+  else        deserializeJson(*dest, f);
+  f.close();
+  return 1;
+}
+
+bool presetLogWrite(uint16_t id, const JsonDocument* content) {
+  size_t len = content->isNull() ? 0 : measureJson(*content);
+  if (len > UINT16_MAX) return false;
+  abortCompaction(); // new record would be lost when the log is removed after compaction
+
+  File f = WLED_FS.open(FPSTR(presets_log), "a");
+  if (!f) return false;
+  uint8_t hdr[4] = { uint8_t(id), uint8_t(id >> 8), uint8_t(len), uint8_t(len >> 8) };
+  f.write(hdr, sizeof(hdr));
+  uint32_t pos = f.position();
+  if (len) serializeJson(*content, f);
+  f.close();
+
+  preset_log_entry_t *e = findLogEntry(id);
+  if (e) { e->pos = pos; e->len = len; }
+  else   logIndex.push_back({pos, (uint16_t)len, id});
+  lastLogWrite = millis();
+  logPending = true;
+  DEBUG_PRINTF_P(PSTR("Preset %u logged (%u bytes).\n"), id, len);
+  return true;
+}
+
+// restore presets.json if compaction was interrupted after removing it
+bool restorePresetLogSnapshot() {
+  if (!WLED_FS.exists(FPSTR(presets_tmp))) return false;
+  return WLED_FS.rename(FPSTR(presets_tmp), FPSTR(getPresetsFileName()));
+}
+
+// build index from log file, called at boot
+void initPresetLog() {
+  logIndex.clear();
+  // compaction was interrupted: if presets.json exists the temporary file is incomplete, otherwise it replaces presets.json
+  if (WLED_FS.exists(FPSTR(getPresetsFileName()))) WLED_FS.remove(FPSTR(presets_tmp));
+  else restorePresetLogSnapshot();
+  File f = WLED_FS.open(FPSTR(presets_log), "r");
+  if (!f) return;
+  const size_t size = f.size();
+  uint32_t pos = 0;
+  uint8_t hdr[4];
+  while (pos + sizeof(hdr) <= size) {
+    f.seek(pos);
+    if (f.read(hdr, sizeof(hdr)) != sizeof(hdr)) break;
+    uint16_t id  = hdr[0] | (hdr[1] << 8);
+    uint16_t len = hdr[2] | (hdr[3] << 8);
+    pos += sizeof(hdr);
+    if (pos + len > size) break; // incomplete record (power loss while saving), ignore
+    preset_log_entry_t *e = findLogEntry(id);
+    if (e) { e->pos = pos; e->len = len; }
+    else   logIndex.push_back({pos, len, id});
+    pos += len;
+  }
+  f.close();
+  DEBUG_PRINTF_P(PSTR("Preset log: %u presets.\n"), logIndex.size());
+  if (!logIndex.empty()) lastLogWrite = millis(); // compact soon after boot
+  logPending = !logIndex.empty();
+}
+
+// called when presets.json is requested (async_tcp task): returns true if it is outdated, compaction then starts without delay
+bool presetLogMergePending() {
+  if (!logPending || compactFailed) return false;
+  compactRequested = true;
+  return true;
+}
+
+static void writeKey(File &out, unsigned id) {
+  char key[10];
+  sprintf_P(key, PSTR("%s\"%u\":"), cFirst ? "" : ",", id);
+  out.print(key);
+  cFirst = false;
+}
+
+// copy presets.json to temporary file, skipping presets that have a log record
+static bool compactCopy() {
+  uint8_t in[PRESET_LOG_CHUNK/2];
+  uint8_t out[PRESET_LOG_CHUNK/2];
+  size_t outLen = 0;
+  size_t n = cIn.read(in, sizeof(in));
+  if (!n) return false; // end of file
+  for (size_t i = 0; i < n; i++) {
+    const uint8_t c = in[i];
+    bool emit = cCopy && cDepth >= 2;
+    if (cInString) {
+      if (cEscaped)         cEscaped = false;
+      else if (c == '\\')   cEscaped = true;
+      else if (c == '"')    cInString = cInKey = false;
+      else if (cInKey)      cKey = (isdigit(c) && cKey >= 0 && cKey < 6553) ? cKey * 10 + (c - '0') : -2;
+    } else switch (c) {
+      case '"':
+        cInString = true;
+        if (cDepth == 1) { cInKey = true; cKey = 0; }
+        break;
+      case '{':
+        if (++cDepth == 2) {
+          cCopy = (cKey >= 0 && !findLogEntry(cKey)); // non-numeric keys are not presets
+          if (cCopy) {
+            if (outLen) { cOut.write(out, outLen); outLen = 0; }
+            writeKey(cOut, cKey);
+            emit = true;
+          }
+          cKey = -1;
+        }
+        break;
+      case '}':
+        if (cDepth) cDepth--;
+        if (cDepth == 0) { // end of root object
+          if (outLen) cOut.write(out, outLen);
+          return false;
+        }
+        break;
+    }
+    if (emit) out[outLen++] = c;
+  }
+  if (outLen) cOut.write(out, outLen);
+  return true;
+}
+
+// append one preset from the log to the temporary file
+static void compactAppend(const preset_log_entry_t &e) {
+  if (!e.len) return;
+  File f = WLED_FS.open(FPSTR(presets_log), "r");
+  if (!f || !f.seek(e.pos)) return;
+  writeKey(cOut, e.id);
+  uint8_t buf[PRESET_LOG_CHUNK/2];
+  size_t left = e.len;
+  while (left) {
+    size_t n = f.read(buf, std::min(left, sizeof(buf)));
+    if (!n) break;
+    cOut.write(buf, n);
+    left -= n;
+  }
+  f.close();
+}
+
+// merge log into presets.json in small steps, called from main loop
+void handlePresetLog() {
+  if (logIndex.empty() || compactFailed) return;
+  // a pending request for presets.json can not wait for idle time (it is deferred until compaction has finished)
+  const bool paused = !compactRequested && realtimeMode && !realtimeOverride; // do not compete with a realtime stream
+  if (compactState == COMPACT_IDLE) {
+    if (presetNeedsSaving() || paused) return;
+    if (!compactRequested && millis() - lastLogWrite < PRESET_LOG_COMPACT_DELAY) return;
+    cIn  = WLED_FS.open(FPSTR(getPresetsFileName()), "r");
+    cOut = WLED_FS.open(FPSTR(presets_tmp), "w");
+    if (!cOut) { cIn.close(); lastLogWrite = millis(); return; } // retry later
+    DEBUG_PRINTLN(F("Preset log compaction started."));
+    cOut.write('{');
+    cDepth = 0; cInString = cEscaped = cInKey = cCopy = false; cFirst = true; cKey = -1;
+    cAppendIdx = 0;
+    cValidate = cacheInvalidate;
+    if (cIn) compactState = COMPACT_COPY;
+    else {
+      writeKey(cOut, 0); // presets.json starts with dummy object "0"
+      cOut.print(F("{}"));
+      compactState = COMPACT_APPEND;
+    }
+    return;
+  }
+  if (cValidate != cacheInvalidate) { // files were uploaded meanwhile
+    abortCompaction();
+    lastLogWrite = millis();
+    return;
+  }
+  if (strip.isUpdating() || paused) return; // accessing FS during sendout causes glitches
+
+  switch (compactState) {
+    case COMPACT_COPY:
+      if (!compactCopy()) { cIn.close(); compactState = COMPACT_APPEND; }
+      break;
+    case COMPACT_APPEND:
+      if (cAppendIdx < logIndex.size()) compactAppend(logIndex[cAppendIdx++]);
+      else compactState = COMPACT_FINISH;
+      break;
+    case COMPACT_FINISH: {
+      cOut.write('}');
+      cOut.close();
+      compactState = COMPACT_IDLE;
+      if (doCloseFile) closeFile(); // file.cpp may still have presets.json open
+      WLED_FS.remove(FPSTR(getPresetsFileName()));
+      if (!restorePresetLogSnapshot()) { // keep log, retry after reboot
+        errorFlag = ERR_FS_GENERAL;
+        compactFailed = true;
+        compactRequested = false;
+        return;
+      }
+      WLED_FS.remove(FPSTR(presets_log));
+      logIndex.clear();
+      logPending = compactRequested = false;
+      DEBUG_PRINTLN(F("Preset log compaction finished."));
+      indexPresetsFile();
+      updateFSInfo();
+      presetsModifiedTime = toki.second(); // UI reloads presets.json
+      updateInterfaces(CALL_MODE_WS_SEND);
+      } break;
+    default: break;
+  }
+}
+
+#endif // WLED_ENABLE_PRESET_LOG
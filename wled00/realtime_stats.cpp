@@ -0,0 +1,155 @@
+#include "wled.h"
+
+/*
+ * Realtime stream statistics
+ * counts packets, bytes, lost/reordered/duplicate packets and frame timing
+ * per E1.31/Art-Net universe and per DDP, TPM2.NET, Hyperion, UDP, serial and WebSocket source
+ */
+
+// deviation of frame interval from its average, upper bucket bounds in ms (last bucket is open ended)
+static const uint8_t jitterBounds[RTSTATS_JITTER_BUCKETS-1] PROGMEM = {1, 2, 5, 10, 20, 50, 100};
+
+typedef struct RealtimeSourceStats {
+  uint32_t packets;
+  uint32_t bytes;
+  uint32_t lost;                 // packets missing according to sequence number
+  uint32_t outOfSequence;        // packets arriving after a newer one
+  uint32_t duplicates;           // packets with repeated sequence number
+  uint32_t dropped;              // packets discarded (i.e. by "skip out-of-sequence packets")
+  uint32_t frames;               // complete frames received
+  unsigned long lastFrame;       // millis() of last complete frame
+  uint16_t avgInterval;          // smoothed frame interval (ms << 4)
+  int16_t  lastSeq;              // -1 if unknown
+  uint16_t jitter[RTSTATS_JITTER_BUCKETS];
+} rt_source_stats_t;
+
+// universes (shared by E1.31 and Art-Net as only one can be active) followed by one entry per other source
+#define RTSTATS_IDX_DDP      (E131_MAX_UNIVERSE_COUNT)
+#define RTSTATS_IDX_TPM2NET  (E131_MAX_UNIVERSE_COUNT+1)
+#define RTSTATS_IDX_HYPERION (E131_MAX_UNIVERSE_COUNT+2)
+#define RTSTATS_IDX_UDP      (E131_MAX_UNIVERSE_COUNT+3)
+#define RTSTATS_IDX_SERIAL   (E131_MAX_UNIVERSE_COUNT+4)
+#define RTSTATS_IDX_WS       (E131_MAX_UNIVERSE_COUNT+5)
+#define RTSTATS_SOURCES      (E131_MAX_UNIVERSE_COUNT+6)
+
+static rt_source_stats_t *rtSources = nullptr; // allocated on first realtime packet
+static uint8_t  rtUniverseMode = REALTIME_MODE_E131; // protocol that last used universe entries
+static uint32_t rtShown = 0;                  // frames shown in realtime mode
+static uint16_t rtAvgLatency = 0;             // smoothed time from frame received to shown (ms << 4)
+static uint16_t rtMaxLatency = 0;
+static unsigned long rtLastFrame = 0;         // millis() of last complete frame of any source
+
+static rt_source_stats_t *getSource(uint8_t mode, unsigned index) {
+  if (!rtSources) {
+    rtSources = static_cast<rt_source_stats_t*>(d_calloc(RTSTATS_SOURCES, sizeof(rt_source_stats_t)));
+    if (!rtSources) return nullptr;
+    for (unsigned i = 0; i < RTSTATS_SOURCES; i++) rtSources[i].lastSeq = -1;
+  }
+  switch (mode) {
+    case REALTIME_MODE_E131:
+    case REALTIME_MODE_ARTNET:
+      if (index >= E131_MAX_UNIVERSE_COUNT) return nullptr;
+      if (rtUniverseMode != mode) { // protocol changed, universe statistics are no longer comparable
+        memset(rtSources, 0, E131_MAX_UNIVERSE_COUNT * sizeof(rt_source_stats_t));
+        for (unsigned i = 0; i < E131_MAX_UNIVERSE_COUNT; i++) rtSources[i].lastSeq = -1;
+        rtUniverseMode = mode;
+      }
+      return &rtSources[index];
+    case REALTIME_MODE_DDP:      return &rtSources[RTSTATS_IDX_DDP];
+    case REALTIME_MODE_TPM2NET:  return &rtSources[RTSTATS_IDX_TPM2NET];
+    case REALTIME_MODE_HYPERION: return &rtSources[RTSTATS_IDX_HYPERION];
+    case REALTIME_MODE_UDP:      return &rtSources[RTSTATS_IDX_UDP];
+    case REALTIME_MODE_ADALIGHT: return &rtSources[RTSTATS_IDX_SERIAL];
+    case REALTIME_MODE_WS:       return &rtSources[RTSTATS_IDX_WS];
+    default:                     return nullptr;
+  }
+}
+
+// record received packet; seq is sequence number (0..seqMod-1) or -1 if the protocol has none
+void rtStatsPacket(uint8_t mode, unsigned index, size_t bytes, int seq, unsigned seqMod) {
+  rt_source_stats_t *src = getSource(mode, index);
+  if (!src) return;
+  src->packets++;
+  src->bytes += bytes;
+  if (seq < 0) return;
+  if (src->lastSeq >= 0) {
+    unsigned diff = (seq - src->lastSeq + seqMod) % seqMod;
+    if (diff == 0)               { src->duplicates++; return; }
+    else if (diff > seqMod / 2)  { src->outOfSequence++; return; } // older than last packet, keep last sequence number
+    else if (diff > 1)           src->lost += diff - 1;
+  }
+  src->lastSeq = seq;
+}
+
+// record packet that was received but not used
+void rtStatsDrop(uint8_t mode, unsigned index) {
+  rt_source_stats_t *src = getSource(mode, index);
+  if (src) src->dropped++;
+}
+
+// record complete frame (for universe based protocols every universe packet completes a frame of that universe)
+void rtStatsFrame(uint8_t mode, unsigned index) {
+  rt_source_stats_t *src = getSource(mode, index);
+  if (!src) return;
+  const unsigned long now = millis();
+  src->frames++;
+  unsigned interval = now - src->lastFrame;
+  if (src->lastFrame && interval < 1000) {
+    if (!src->avgInterval) src->avgInterval = interval << 4;
+    unsigned avg = src->avgInterval >> 4;
+    unsigned dev = interval > avg ? interval - avg : avg - interval;
+    unsigned b = 0;
+    while (b < RTSTATS_JITTER_BUCKETS-1 && dev >= pgm_read_byte(&jitterBounds[b])) b++;
+    if (src->jitter[b] < UINT16_MAX) src->jitter[b]++;
+    src->avgInterval = (7 * src->avgInterval + (interval << 4)) / 8;
+  }
+  src->lastFrame = now;
+  rtLastFrame = now;
+}
+
+// record frame shown while in realtime mode
+void rtStatsShown() {
+  if (!rtSources || !rtLastFrame) return;
+  rtShown++;
+  unsigned latency = millis() - rtLastFrame;
+  if (latency > 1000) return; // not caused by a received frame
+  if (latency > rtMaxLatency) rtMaxLatency = latency;
+  rtAvgLatency = rtShown > 1 ? (7 * rtAvgLatency + (latency << 4)) / 8 : latency << 4;
+}
+
+void serializeRealtimeStats(JsonObject root) {
+  if (!rtSources) return;
+  JsonObject rts = root.createNestedObject(F("rts"));
+  rts[F("shown")] = rtShown;
+  JsonArray lat = rts.createNestedArray(F("lat")); // [avg, max] ms from frame received to shown
+  lat.add(rtAvgLatency >> 4);
+  lat.add(rtMaxLatency);
+  JsonArray srcs = rts.createNestedArray(F("src"));
+  for (unsigned i = 0; i < RTSTATS_SOURCES; i++) {
+    const rt_source_stats_t &src = rtSources[i];
+    if (!src.packets) continue;
+    JsonObject s = srcs.createNestedObject();
+    switch (i) {
+      case RTSTATS_IDX_DDP:      s["p"] = F("DDP"); break;
+      case RTSTATS_IDX_TPM2NET:  s["p"] = F("tpm2.net"); break;
+      case RTSTATS_IDX_HYPERION: s["p"] = F("Hyperion"); break;
+      case RTSTATS_IDX_UDP:      s["p"] = F("UDP"); break;
+      case RTSTATS_IDX_SERIAL:   s["p"] = F("Serial"); break;
+      case RTSTATS_IDX_WS:       s["p"] = F("WebSocket"); break;
+      default:
+        s["p"] = rtUniverseMode == REALTIME_MODE_ARTNET ? F("Art-Net") : F("E1.31");
+        s["u"] = e131Universe + i;
+        break;
+    }
+    s[F("pkt")]  = src.packets;
+    s["b"]       = src.bytes;
+    s[F("lost")] = src.lost;
+    s[F("oos")]  = src.outOfSequence;
+    s[F("dup")]  = src.duplicates;
+    s[F("drop")] = src.dropped;
+    s[F("frm")]  = src.frames;
+    s[F("fps")]  = src.avgInterval ? (1000 << 4) / src.avgInterval : 0;
+    JsonArray jit = s.createNestedArray(F("jit")); // histogram of frame interval deviation: <1,<2,<5,<10,<20,<50,<100,>=100 ms
+    for (unsigned b = 0; b < RTSTATS_JITTER_BUCKETS; b++) jit.add(src.jitter[b]);
+  }
+}
@@ -0,0 +1,126 @@
+#include "wled.h"
+
+/*
+ * Cooperative scheduler for periodic background jobs (sensor reads in usermods, housekeeping)
+ * Jobs are run by handleJobs() after strip.service(), in the time left until the next frame is due.
+ * A job is due once its period has elapsed. It runs if its time budget fits into the remaining slack,
+ * or unconditionally once its deadline (period + max. delay) has passed ("late" run).
+ * Runs taking longer than the budget are counted as overruns, statistics are listed in /json/perf.
+ * Jobs must be added, removed and triggered from the main loop (or setup()), never from async callbacks.
+ */
+
+#ifndef WLED_MAX_JOBS
+  #ifdef ESP8266
+    #define WLED_MAX_JOBS 8
+  #else
+    #define WLED_MAX_JOBS 16
+  #endif
+#endif
+
+typedef struct Job {
+  job_fn_t      fn;       // nullptr: free slot
+  void         *arg;
+  const char   *name;     // PROGMEM string or nullptr
+  uint32_t      period;   // ms
+  uint16_t      budget;   // us
+  uint16_t      maxDelay; // ms
+  unsigned long lastRun;  // ms
+  uint32_t      runs;
+  uint32_t      overruns; // runs exceeding the budget
+  uint32_t      late;     // runs forced by the deadline
+  uint32_t      maxTime;  // us
+} job_t;
+
+static job_t    jobs[WLED_MAX_JOBS];
+static unsigned jobNext = 0; // round robin start, so jobs with equal deadlines share the slack
+
+// returns job id or -1 if no free slot; the first run is due immediately
+int addJob(job_fn_t fn, void *arg, uint32_t periodMs, uint16_t budgetUs, uint16_t maxDelayMs, const char *name)
+{
+  if (!fn) return -1;
+  for (int i = 0; i < WLED_MAX_JOBS; i++) {
+    if (jobs[i].fn) continue;
+    jobs[i] = {fn, arg, name, periodMs, budgetUs, maxDelayMs, millis() - periodMs, 0, 0, 0, 0};
+    DEBUG_PRINTF_P(PSTR("Job %d added (%ums, %uus).\n"), i, (unsigned)periodMs, budgetUs);
+    return i;
+  }
+  DEBUG_PRINTLN(F("No free job slot!"));
+  return -1;
+}
+
+void removeJob(int id)
+{
+  if (id >= 0 && id < WLED_MAX_JOBS) jobs[id].fn = nullptr;
+}
+
+// make job due now (i.e. after reconnecting)
+void triggerJob(int id)
+{
+  if (id >= 0 && id < WLED_MAX_JOBS && jobs[id].fn) jobs[id].lastRun = millis() - jobs[id].period;
+}
+
+// time (us) until the next frame is due
+static long getFrameSlack(unsigned long now)
+{
+  const unsigned frameTime = strip.getFrameTime();
+  const long untilDue = (long)(strip.getLastShow() + frameTime - now);
+  if (untilDue > 0) return untilDue * 1000L;
+  // no frame shown for more than one frame time: static effect, off or live data (strip is idle)
+  if (now - strip.getLastShow() > 2*frameTime) return frameTime * 1000L;
+  return 0; // frame is due (or unlimited FPS), only late jobs may run
+}
+
+void handleJobs()
+{
+  const unsigned long now   = millis();
+  const unsigned long start = micros();
+  const long          slack = getFrameSlack(now);
+  const unsigned      first = jobNext;
+
+  for (unsigned n = 0; n < WLED_MAX_JOBS; n++) {
+    const unsigned i = (first + n) % WLED_MAX_JOBS;
+    job_t &job = jobs[i];
+    if (!job.fn) continue;
+    const unsigned long elapsed = now - job.lastRun;
+    if (elapsed < job.period) continue;
+    const bool overdue = elapsed >= job.period + job.maxDelay;
+    const bool fits    = (long)job.budget <= slack - (long)(micros() - start);
+    if (!fits && !overdue) continue;
+
+    const unsigned long t0 = micros();
+    job.fn(job.arg);
+    const uint32_t t = micros() - t0;
+
+    job.lastRun = now;
+    job.runs++;
+    if (!fits) job.late++;
+    if (t > job.maxTime) job.maxTime = t;
+    if (t > job.budget) {
+      job.overruns++;
+      DEBUG_PRINTF_P(PSTR("Job %d overran its budget: %uus > %uus\n"), i, (unsigned)t, job.budget);
+    }
+    jobNext = i + 1;
+  }
+}
+
+void serializeJobs(JsonArray arr)
+{
+  for (unsigned i = 0; i < WLED_MAX_JOBS; i++) {
+    const job_t &job = jobs[i];
+    if (!job.fn) continue;
+    JsonObject obj = arr.createNestedObject();
+    obj["id"] = i;
+    if (job.name) obj["name"] = FPSTR(job.name); // copied
+    obj[F("period")] = job.period;
+    obj[F("budget")] = job.budget;
+    obj["n"]         = job.runs;
+    obj[F("max")]    = job.maxTime;
+    obj[F("over")]   = job.overruns;
+    obj[F("late")]   = job.late;
+  }
+}
+
+void resetJobStats()
+{
+  for (auto &job : jobs) job.runs = job.overruns = job.late = job.maxTime = 0;
+}
@@ -0,0 +1,131 @@
+#include "wled.h"
+#include "trace.h"
+
+/*
+ * Event tracer (begin/end/instant events in a fixed size ring buffer)
+ * Download /json/trace and open it in https://ui.perfetto.dev or chrome://tracing (/json/trace?clear empties the buffer)
+ * Set WLED_TRACE_EVENTS to 0 to disable.
+ */
+#ifndef WLED_TRACE_EVENTS
+  #ifdef ESP8266
+    #define WLED_TRACE_EVENTS 128
+  #else
+    #define WLED_TRACE_EVENTS 512
+  #endif
+#endif
+
+static const char traceNames[TRACE_NAME_COUNT][14] PROGMEM = {
+  "service", "show", "bus show", "ABL limiting", "preset save", "preset apply", "json", "ws event", "e131"
+};
+
+#if WLED_TRACE_EVENTS > 0
+static trace_event_t traceStorage[WLED_TRACE_EVENTS];
+static TraceRing     traceRing(traceStorage, WLED_TRACE_EVENTS);
+#ifdef ARDUINO_ARCH_ESP32
+static portMUX_TYPE  traceMux = portMUX_INITIALIZER_UNLOCKED;
+static TaskHandle_t  traceTasks[TRACE_MAX_TIDS] = {nullptr}; // tid of a task is its index, 0 is the loop task
+static char          traceTaskNames[TRACE_MAX_TIDS][16];
+
+// tid of a task, assigned on its first event (call with traceMux held)
+static uint8_t traceTid(TaskHandle_t task)
+{
+  for (unsigned i = 0; i < TRACE_MAX_TIDS; i++) {
+    if (traceTasks[i] == task) return i;
+    if (traceTasks[i]) continue;
+    traceTasks[i] = task;
+    strlcpy(traceTaskNames[i], pcTaskGetTaskName(task), sizeof(traceTaskNames[i]));
+    return i;
+  }
+  return TRACE_MAX_TIDS-1; // out of tracks
+}
+#endif
+#endif
+
+// must be called from setup() (loop task) to tell loop and async events apart
+void traceInit()
+{
+  #if WLED_TRACE_EVENTS > 0 && defined(ARDUINO_ARCH_ESP32)
+  portENTER_CRITICAL(&traceMux);
+  traceTasks[0] = xTaskGetCurrentTaskHandle();
+  strcpy(traceTaskNames[0], "loop");
+  portEXIT_CRITICAL(&traceMux);
+  #endif
+}
+
+void traceEvent(uint8_t name, char phase, uint8_t arg)
+{
+  #if WLED_TRACE_EVENTS > 0
+  const uint32_t ts = micros();
+  #ifdef ARDUINO_ARCH_ESP32
+  const TaskHandle_t task = xTaskGetCurrentTaskHandle();
+  portENTER_CRITICAL(&traceMux);
+  traceRing.add(ts, name, phase, traceTid(task), arg);
+  portEXIT_CRITICAL(&traceMux);
+  #else
+  traceRing.add(ts, name, phase, can_yield() ? 0 : 1, arg); // network callbacks run in system context
+  #endif
+  #endif
+}
+
+static const char *traceName(uint8_t name)
+{
+  static char buf[sizeof(traceNames[0])];
+  strcpy_P(buf, name < TRACE_NAME_COUNT ? traceNames[name] : PSTR("?"));
+  return buf;
+}
+
+static const char *traceTidName(unsigned tid)
+{
+  #if WLED_TRACE_EVENTS > 0 && defined(ARDUINO_ARCH_ESP32)
+  if (tid >= TRACE_MAX_TIDS || !traceTasks[tid]) return nullptr;
+  return traceTaskNames[tid]; // names do not change once assigned
+  #else
+  return tid == 0 ? "loop" : tid == 1 ? "sys" : nullptr;
+  #endif
+}
+
+void serveTrace(AsyncWebServerRequest* request)
+{
+  #if WLED_TRACE_EVENTS > 0
+  if (request->hasParam(F("clear"))) {
+    #ifdef ARDUINO_ARCH_ESP32
+    portENTER_CRITICAL(&traceMux);
+    #endif
+    traceRing.clear();
+    #ifdef ARDUINO_ARCH_ESP32
+    portEXIT_CRITICAL(&traceMux);
+    #endif
+    serveJsonSuccess(request);
+    return;
+  }
+  // copy events so the ring can continue recording while the response is sent
+  std::shared_ptr<trace_event_t> events(static_cast<trace_event_t*>(malloc(WLED_TRACE_EVENTS * sizeof(trace_event_t))), free);
+  if (!events) {
+    serveJsonError(request, 503, ERR_NOBUF);
+    return;
+  }
+  #ifdef ARDUINO_ARCH_ESP32
+  portENTER_CRITICAL(&traceMux);
+  #endif
+  const size_t n = traceRing.copy(events.get(), WLED_TRACE_EVENTS);
+  #ifdef ARDUINO_ARCH_ESP32
+  portEXIT_CRITICAL(&traceMux);
+  #endif
+  #else
+  std::shared_ptr<trace_event_t> events;
+  const size_t n = 0;
+  #endif
+
+  CountingPrint counter; // first pass for content length
+  writeChromeTrace(counter, events.get(), n, traceName, traceTidName);
+  const size_t len = counter.count();
+  // each chunk is written by skipping the output before index (formatting is cheap compared to holding the whole text in RAM)
+  AsyncWebServerResponse *response = request->beginResponse(FPSTR(CONTENT_TYPE_JSON), len, [events, n, len](uint8_t *buf, size_t maxLen, size_t index) -> size_t {
+    if (index >= len) return 0;
+    ChunkPrint dest(buf, index, maxLen);
+    writeChromeTrace(dest, events.get(), n, traceName, traceTidName);
+    return min(maxLen, len - index);
+  });
+  response->addHeader(F("Content-Disposition"), F("attachment; filename=\"wled-trace.json\""));
+  request->send(response);
+}
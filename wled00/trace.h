@@ -0,0 +1,93 @@
+#pragma once
+#ifndef WLED_TRACE_H
+#define WLED_TRACE_H
+/*
+ * Event tracer ring buffer and Chrome trace (JSON) writer
+ * This header does not depend on Arduino so it can be compiled and tested on a host.
+ * Platform glue (clock, locking, event names, web server) is in trace.cpp.
+ */
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+
+// event phases as used in the Chrome trace event format
+#define TRACE_PH_BEGIN   'B'
+#define TRACE_PH_END     'E'
+#define TRACE_PH_INSTANT 'i'
+
+typedef struct TraceEvent {
+  uint32_t ts;    // us (wraps after ~71 minutes, events are exported relative to the oldest one)
+  uint8_t  name;  // index into name table
+  char     phase; // TRACE_PH_*
+  uint8_t  tid;   // 0: main loop, others: async (network) tasks, see trace.cpp
+  uint8_t  arg;   // optional argument (i.e. segment, universe or preset)
+} trace_event_t;
+
+// fixed size ring buffer, oldest events are overwritten (caller provides storage and locking)
+class TraceRing {
+  trace_event_t *_ev;
+  size_t _size;
+  size_t _head = 0;  // next write position
+  size_t _count = 0;
+  public:
+  TraceRing(trace_event_t *storage, size_t size) : _ev(storage), _size(size) {}
+
+  void add(uint32_t ts, uint8_t name, char phase, uint8_t tid, uint8_t arg) {
+    if (!_size) return;
+    trace_event_t &e = _ev[_head];
+    e.ts = ts; e.name = name; e.phase = phase; e.tid = tid; e.arg = arg;
+    if (++_head == _size) _head = 0;
+    if (_count < _size) _count++;
+  }
+  void clear() { _head = _count = 0; }
+  size_t count() const { return _count; }
+  // i = 0 is the oldest event
+  const trace_event_t &get(size_t i) const { return _ev[(_head + _size - _count + i) % _size]; }
+  // copies events oldest first, returns number of events copied
+  size_t copy(trace_event_t *dst, size_t max) const {
+    size_t n = _count < max ? _count : max;
+    for (size_t i = 0; i < n; i++) dst[i] = get(_count - n + i);
+    return n;
+  }
+};
+
+#ifndef TRACE_MAX_TIDS
+  #define TRACE_MAX_TIDS 4 // tracks (tasks), events of further tasks share the last one
+#endif
+
+/*
+ * writes {"traceEvents":[...]} (Chrome trace / Perfetto) from events ordered oldest first
+ * Out must provide print(const char*), nameOf returns the name of an event name index, tidName the name of a thread (nullptr if unused)
+ * end events whose begin event was already overwritten are dropped
+ */
+template <class Out, class NameFn, class TidFn>
+void writeChromeTrace(Out &out, const trace_event_t *ev, size_t n, NameFn nameOf, TidFn tidName)
+{
+  char buf[96];
+  out.print("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+  bool first = true;
+  for (unsigned t = 0; t < TRACE_MAX_TIDS; t++) {
+    const char *tname = tidName(t);
+    if (!tname) continue;
+    snprintf(buf, sizeof(buf), "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"}}", first ? "" : ",", t, tname);
+    out.print(buf);
+    first = false;
+  }
+  unsigned depth[TRACE_MAX_TIDS] = {0};
+  const uint32_t t0 = n ? ev[0].ts : 0;
+  for (size_t i = 0; i < n; i++) {
+    const trace_event_t &e = ev[i];
+    const unsigned tid = e.tid < TRACE_MAX_TIDS ? e.tid : TRACE_MAX_TIDS-1;
+    if (e.phase == TRACE_PH_BEGIN) depth[tid]++;
+    else if (e.phase == TRACE_PH_END) {
+      if (!depth[tid]) continue; // begin not in buffer
+      depth[tid]--;
+    }
+    snprintf(buf, sizeof(buf), ",{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%lu,\"pid\":1,\"tid\":%u%s,\"args\":{\"a\":%u}}",
+             nameOf(e.name), e.phase, (unsigned long)(uint32_t)(e.ts - t0), tid, e.phase == TRACE_PH_INSTANT ? ",\"s\":\"t\"" : "", e.arg);
+    out.print(buf);
+  }
+  out.print("]}");
+}
+
+#endif
@@ -17,7 +17,59 @@ typedef struct PartialEspNowPacket {
   uint8_t data[247];
 } partial_packet_t;
 
-void notify(byte callMode, bool followUp)
+// outbound sync scheduler: changes within notifyWindow ms are merged into one notification
+static byte          notifyPendingMode  = CALL_MODE_INIT; // call mode of the pending notification (INIT: none)
+static bool          notifyPendingForce = false;          // send even if state did not change (i.e. preset applied)
+static unsigned long notifyPendingTime  = 0;              // time of the first change in the window
+static bool          sysInfoPending     = false;
+static uint32_t      notifySentHash     = 0;              // hash of last sent state (0: unknown)
+
+static bool notifyAllowed(byte callMode)
+{
+  switch (callMode)
+  {
+    case CALL_MODE_DIRECT_CHANGE: return notifyDirect;
+    case CALL_MODE_BUTTON:        return notifyButton;
+    case CALL_MODE_BUTTON_PRESET: return notifyButton;
+    case CALL_MODE_NIGHTLIGHT:    return notifyDirect;
+    case CALL_MODE_HUE:           return notifyHue;
+    case CALL_MODE_PRESET_CYCLE:  return notifyDirect;
+    case CALL_MODE_ALEXA:         return notifyAlexa;
+    default:                      return false;
+  }
+}
+
+// queue a sync notification (sent from handleNotifications() once the window has passed)
+void scheduleNotify(byte callMode, bool force)
+{
+  if (!notifyAllowed(callMode)) return;
+  if (notifyPendingMode == CALL_MODE_INIT) notifyPendingTime = millis();
+  notifyPendingMode  = callMode; // last change wins
+  notifyPendingForce |= force;
+}
+
+// queue a node info broadcast (i.e. brightness changed)
+void scheduleSysInfoUDP()
+{
+  sysInfoPending = true;
+}
+
+static void handleNotifySchedule()
+{
+  if (notifyPendingMode != CALL_MODE_INIT && millis() - notifyPendingTime >= notifyWindow) {
+    byte callMode = notifyPendingMode;
+    bool force    = notifyPendingForce;
+    notifyPendingMode  = CALL_MODE_INIT;
+    notifyPendingForce = false;
+    notify(callMode, false, force);
+  }
+  if (sysInfoPending) {
+    sysInfoPending = false;
+    sendSysInfoUDP();
+  }
+}
+
+void notify(byte callMode, bool followUp, bool force)
 {
 #ifndef WLED_DISABLE_ESPNOW
   if (!udpConnected && !useESPNowSync) return;
@@ -25,18 +77,7 @@ void notify(byte callMode, bool followUp)
   if (!udpConnected) return;
 #endif
   if (!syncGroups || !sendNotificationsRT) return;
-  switch (callMode)
-  {
-    case CALL_MODE_INIT:          return;
-    case CALL_MODE_DIRECT_CHANGE: if (!notifyDirect) return; break;
-    case CALL_MODE_BUTTON:        if (!notifyButton) return; break;
-    case CALL_MODE_BUTTON_PRESET: if (!notifyButton) return; break;
-    case CALL_MODE_NIGHTLIGHT:    if (!notifyDirect) return; break;
-    case CALL_MODE_HUE:           if (!notifyHue)    return; break;
-    case CALL_MODE_PRESET_CYCLE:  if (!notifyDirect) return; break;
-    case CALL_MODE_ALEXA:         if (!notifyAlexa)  return; break;
-    default: return;
-  }
+  if (!notifyAllowed(callMode)) return;
   byte udpOut[WLEDPACKETSIZE];  //TODO: optimize size to use only active segments
   Segment& mainseg = strip.getMainSegment();
   udpOut[0] = 0; //0: wled notifier protocol 1: WARLS protocol
@@ -149,6 +190,13 @@ void notify(byte callMode, bool followUp)
   //uint16_t offs = SEG_OFFSET;
   //next value to be added has index: udpOut[offs + 0]
 
+  // skip if synced state is unchanged since the last notification (merged changes may cancel out)
+  // call mode, follow-up flag, timebase and time (bytes 24-35) are not part of the state
+  uint32_t hash = hashBuffer(udpOut+2, 22);
+  hash = hashBuffer(udpOut+36, 5 + s*UDP_SEG_SIZE, hash);
+  if (!followUp && !force && hash == notifySentHash) return;
+  notifySentHash = hash;
+
 #ifndef WLED_DISABLE_ESPNOW
   if (enableESPNow && useESPNowSync && statusESPNow == ESP_NOW_STATE_ON) {
     partial_packet_t buffer = {'W', 0, 1, {0}};
@@ -210,6 +258,7 @@ static void parseNotifyPacket(const uint8_t *udpIn) {
   //ignore notification if received within a second after sending a notification ourselves
   if (millis() - notificationSentTime < 1000) return;
   if (udpIn[1] > 199) return; //do not receive custom versions
+  notifySentHash = 0; // state may change, next own notification must be sent
 
   //compatibilityVersionByte:
   byte version = udpIn[11];
@@ -469,17 +518,22 @@ void handleNotifications()
 {
   IPAddress localIP;
 
+  handleNotifySchedule();
+
   //send second notification if enabled
   if(udpConnected && (notificationCount < udpNumRetries) && ((millis()-notificationSentTime) > 250)){
     notify(notificationSentCallMode,true);
   }
 
-  if (e131NewData && millis() - strip.getLastShow() > 15)
+  if (e131NewData && (e131SyncFrame || millis() - strip.getLastShow() > 15))
   {
     e131NewData = false;
+    e131SyncFrame = false;
     if (useMainSegmentOnly) strip.trigger();
     else                    strip.show();
+    rtStatsShown();
   }
+  handleDDPJitterBuffer();
 
   //unlock strip when realtime UDP times out
   if (realtimeMode && millis() > realtimeTimeout) exitRealtime();
@@ -505,6 +559,8 @@ void handleNotifications()
       uint8_t lbuf[packetSize];
       rgbUdp.read(lbuf, packetSize);
       realtimeLock(realtimeTimeoutMs, REALTIME_MODE_HYPERION);
+      rtStatsPacket(REALTIME_MODE_HYPERION, 0, packetSize);
+      rtStatsFrame(REALTIME_MODE_HYPERION);
       if (realtimeOverride) return;
       unsigned totalLen = strip.getLengthTotal();
       for (size_t i = 0, id = 0; i < packetSize -2 && id < totalLen; i += 3, id++) {
@@ -512,6 +568,7 @@ void handleNotifications()
       }
       if (useMainSegmentOnly) strip.trigger();
       else                    strip.show();
+      rtStatsShown();
       return;
     }
   }
@@ -578,6 +635,7 @@ void handleNotifications()
 
       realtimeIP = (isSupp) ? notifier2Udp.remoteIP() : notifierUdp.remoteIP();
       realtimeLock(realtimeTimeoutMs, REALTIME_MODE_TPM2NET);
+      rtStatsPacket(REALTIME_MODE_TPM2NET, 0, packetSize);
       if (realtimeOverride) return;
 
       tpmPacketCount++; //increment the packet count
@@ -592,8 +650,10 @@ void handleNotifications()
       }
       if (tpmPacketCount == numPackets) { //reset packet count and show if all packets were received
         tpmPacketCount = 0;
+        rtStatsFrame(REALTIME_MODE_TPM2NET);
         if (useMainSegmentOnly) strip.trigger();
         else                    strip.show();
+        rtStatsShown();
       }
       return;
     }
@@ -610,6 +670,8 @@ void handleNotifications()
       } else {
         realtimeLock(udpIn[1]*1000 +1, REALTIME_MODE_UDP);
       }
+      rtStatsPacket(REALTIME_MODE_UDP, 0, packetSize);
+      rtStatsFrame(REALTIME_MODE_UDP);
       if (realtimeOverride) return;
 
       unsigned totalLen = strip.getLengthTotal();
@@ -639,6 +701,7 @@ void handleNotifications()
       }
       if (useMainSegmentOnly) strip.trigger();
       else                    strip.show();
+      rtStatsShown();
       return;
     }
   }
@@ -669,6 +732,19 @@ void setRealtimePixel(uint16_t i, byte r, byte g, byte b, byte w)
   strip.setRealtimePixelColor(pix, RGBW32(r,g,b,w));
 }
 
+// bulk version of setRealtimePixel(), data contains count consecutive RGB or RGBW pixels
+void setRealtimePixels(unsigned start, const byte* data, unsigned count, bool isRGBW)
+{
+  int pix = start + arlsOffset;
+  if (pix < 0) { // skip pixels shifted below start of strip
+    if (unsigned(-pix) >= count) return;
+    data  += unsigned(-pix) * (isRGBW ? 4 : 3);
+    count -= unsigned(-pix);
+    pix = 0;
+  }
+  strip.setRealtimePixels(pix, data, count, isRGBW);
+}
+
 /*********************************************************************************************\
    Refresh aging for remote units, drop if too old...
 \*********************************************************************************************/
@@ -781,6 +857,8 @@ void sendSysInfoUDP()
 static       size_t sequenceNumber = 0; // this needs to be shared across all outputs
 static const size_t ART_NET_HEADER_SIZE = 12;
 static const byte   ART_NET_HEADER[] PROGMEM = {0x41,0x72,0x74,0x2d,0x4e,0x65,0x74,0x00,0x00,0x50,0x00,0x0e};
+static const size_t ART_SYNC_SIZE = 14;
+static const byte   ART_SYNC_PACKET[] PROGMEM = {0x41,0x72,0x74,0x2d,0x4e,0x65,0x74,0x00,0x00,0x52,0x00,0x0e,0x00,0x00}; // OpSync, Aux1 & Aux2 = 0
 
 uint8_t realtimeBroadcast(uint8_t type, IPAddress client, uint16_t length, const uint8_t *buffer, uint8_t bri, bool isRGBW)  {
   if (!(apActive || interfacesInited) || !client[0] || !length) return 1;  // network not initialised or dummy/unset IP address  031522 ajn added check for ap
@@ -909,6 +987,17 @@ uint8_t realtimeBroadcast(uint8_t type, IPAddress client, uint16_t length, const
         }
         channel += packetSize;
       }
+
+      // ArtSync after last universe so that synchronous receivers output all universes at once
+      // (receivers not supporting ArtSync ignore it)
+      if (!ddpUdp.beginPacket(client, ARTNET_DEFAULT_PORT)) return 1;
+      byte sync_buffer[ART_SYNC_SIZE];
+      memcpy_P(sync_buffer, ART_SYNC_PACKET, ART_SYNC_SIZE);
+      ddpUdp.write(sync_buffer, ART_SYNC_SIZE);
+      if (!ddpUdp.endPacket()) {
+        DEBUG_PRINTLN(F("Art-Net ArtSync WiFiUDP.endPacket returned an error"));
+        return 1; // borked
+      }
     } break;
   }
   return 0;
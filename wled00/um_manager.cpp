@@ -17,17 +17,77 @@ static size_t getCount() {
   return &_usermod_table_end[0] - &_usermod_table_begin[0];
 }
 
+/*
+ * Per hook dispatch lists for frequently called hooks
+ * Only usermods that override a hook are added to its list, so usermods using the empty Usermod implementation
+ * cost nothing. Overrides are detected by comparing the function a virtual call would execute with Usermod's
+ * implementation (GCC bound member function extension). An override the linker folded with the base
+ * implementation (identical code) is an empty one anyway.
+ */
+enum UsermodHook : uint8_t {
+  UM_HOOK_OVERLAY, UM_HOOK_BUTTON, UM_HOOK_ADD_STATE, UM_HOOK_READ_STATE, UM_HOOK_MQTT_MSG, UM_HOOK_ESPNOW_MSG, UM_HOOK_UDP, UM_HOOK_STATE_CHANGE,
+  UM_HOOK_COUNT
+};
+
+// implements nothing but the pure virtual functions, provides the addresses of Usermod's hook implementations
+class UsermodNone : public Usermod {
+  public:
+  void setup() override {}
+  void loop() override {}
+};
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpmf-conversions"
+#define UM_HOOK_IMPL(mod, hook) ((void*)((mod)->*(&Usermod::hook)))
+#define UM_OVERRIDES(mod, hook) (UM_HOOK_IMPL(mod, hook) != UM_HOOK_IMPL(&none, hook))
+
+static std::vector<Usermod*> hookLists[UM_HOOK_COUNT];
+static bool hookListsValid = false;
+
+static void initHookLists() {
+  UsermodNone none;
+  for (auto &list : hookLists) list.clear();
+  for (auto mod = _usermod_table_begin; mod < _usermod_table_end; ++mod) {
+    if (UM_OVERRIDES(*mod, handleOverlayDraw)) hookLists[UM_HOOK_OVERLAY].push_back(*mod);
+    if (UM_OVERRIDES(*mod, handleButton))      hookLists[UM_HOOK_BUTTON].push_back(*mod);
+    if (UM_OVERRIDES(*mod, addToJsonState))    hookLists[UM_HOOK_ADD_STATE].push_back(*mod);
+    if (UM_OVERRIDES(*mod, readFromJsonState)) hookLists[UM_HOOK_READ_STATE].push_back(*mod);
+    if (UM_OVERRIDES(*mod, onMqttMessage))     hookLists[UM_HOOK_MQTT_MSG].push_back(*mod);
+    if (UM_OVERRIDES(*mod, onEspNowMessage))   hookLists[UM_HOOK_ESPNOW_MSG].push_back(*mod);
+    if (UM_OVERRIDES(*mod, onUdpPacket))       hookLists[UM_HOOK_UDP].push_back(*mod);
+    if (UM_OVERRIDES(*mod, onStateChange))     hookLists[UM_HOOK_STATE_CHANGE].push_back(*mod);
+  }
+  for (auto &list : hookLists) list.shrink_to_fit();
+  hookListsValid = true;
+}
+#pragma GCC diagnostic pop
+
+// hooks may be dispatched before UsermodManager::setup() (i.e. config loading)
+static inline const std::vector<Usermod*> &getHookList(UsermodHook hook) {
+  if (!hookListsValid) initHookLists();
+  return hookLists[hook];
+}
+
+#define FOR_EACH_HOOK(hook, mod) for (Usermod *mod : getHookList(hook))
+
 
 //Usermod Manager internals
-void UsermodManager::setup()             { for (auto mod = _usermod_table_begin; mod < _usermod_table_end; ++mod) (*mod)->setup(); }
+void UsermodManager::setup()             { if (!hookListsValid) initHookLists(); for (auto mod = _usermod_table_begin; mod < _usermod_table_end; ++mod) (*mod)->setup(); }
 void UsermodManager::connected()         { for (auto mod = _usermod_table_begin; mod < _usermod_table_end; ++mod) (*mod)->connected(); }
-void UsermodManager::loop()              { for (auto mod = _usermod_table_begin; mod < _usermod_table_end; ++mod) (*mod)->loop();  }
-void UsermodManager::handleOverlayDraw() { for (auto mod = _usermod_table_begin; mod < _usermod_table_end; ++mod) (*mod)->handleOverlayDraw(); }
+void UsermodManager::loop() {
+  // loop() is pure virtual (always implemented), time spent is accounted per usermod (see /json/perf)
+  for (size_t i = 0; i < getCount(); i++) {
+    const unsigned long start = micros();
+    _usermod_table_begin[i]->loop();
+    perfRecordUsermod(i, start);
+  }
+}
+void UsermodManager::handleOverlayDraw() { FOR_EACH_HOOK(UM_HOOK_OVERLAY, mod) mod->handleOverlayDraw(); }
 void UsermodManager::appendConfigData(Print& dest)  { for (auto mod = _usermod_table_begin; mod < _usermod_table_end; ++mod) (*mod)->appendConfigData(dest); }
 bool UsermodManager::handleButton(uint8_t b) {
   bool overrideIO = false;
-  for (auto mod = _usermod_table_begin; mod < _usermod_table_end; ++mod) {
-    if ((*mod)->handleButton(b)) overrideIO = true;
+  FOR_EACH_HOOK(UM_HOOK_BUTTON, mod) {
+    if (mod->handleButton(b)) overrideIO = true;
   }
   return overrideIO;
 }
@@ -38,7 +98,7 @@ bool UsermodManager::getUMData(um_data_t **data, uint8_t mod_id) {
   }
   return false;
 }
-void UsermodManager::addToJsonState(JsonObject& obj)    { for (auto mod = _usermod_table_begin; mod < _usermod_table_end; ++mod) (*mod)->addToJsonState(obj); }
+void UsermodManager::addToJsonState(JsonObject& obj)    { FOR_EACH_HOOK(UM_HOOK_ADD_STATE, mod) mod->addToJsonState(obj); }
 void UsermodManager::addToJsonInfo(JsonObject& obj)     {
   auto um_id_list = obj.createNestedArray("um");  
   for (auto mod = _usermod_table_begin; mod < _usermod_table_end; ++mod) {
@@ -46,7 +106,7 @@ void UsermodManager::addToJsonInfo(JsonObject& obj)     {
     (*mod)->addToJsonInfo(obj);
   }
 }
-void UsermodManager::readFromJsonState(JsonObject& obj) { for (auto mod = _usermod_table_begin; mod < _usermod_table_end; ++mod) (*mod)->readFromJsonState(obj); }
+void UsermodManager::readFromJsonState(JsonObject& obj) { FOR_EACH_HOOK(UM_HOOK_READ_STATE, mod) mod->readFromJsonState(obj); }
 void UsermodManager::addToConfig(JsonObject& obj)       { for (auto mod = _usermod_table_begin; mod < _usermod_table_end; ++mod) (*mod)->addToConfig(obj); }
 bool UsermodManager::readFromConfig(JsonObject& obj)    {
   bool allComplete = true;
@@ -58,22 +118,22 @@ bool UsermodManager::readFromConfig(JsonObject& obj)    {
 #ifndef WLED_DISABLE_MQTT
 void UsermodManager::onMqttConnect(bool sessionPresent) { for (auto mod = _usermod_table_begin; mod < _usermod_table_end; ++mod) (*mod)->onMqttConnect(sessionPresent); }
 bool UsermodManager::onMqttMessage(char* topic, char* payload) {
-  for (auto mod = _usermod_table_begin; mod < _usermod_table_end; ++mod) if ((*mod)->onMqttMessage(topic, payload)) return true;
+  FOR_EACH_HOOK(UM_HOOK_MQTT_MSG, mod) if (mod->onMqttMessage(topic, payload)) return true;
   return false;
 }
 #endif
 #ifndef WLED_DISABLE_ESPNOW
 bool UsermodManager::onEspNowMessage(uint8_t* sender, uint8_t* payload, uint8_t len) {
-  for (auto mod = _usermod_table_begin; mod < _usermod_table_end; ++mod) if ((*mod)->onEspNowMessage(sender, payload, len)) return true;
+  FOR_EACH_HOOK(UM_HOOK_ESPNOW_MSG, mod) if (mod->onEspNowMessage(sender, payload, len)) return true;
   return false;
 }
 #endif
 bool UsermodManager::onUdpPacket(uint8_t* payload, size_t len) {
-  for (auto mod = _usermod_table_begin; mod < _usermod_table_end; ++mod) if ((*mod)->onUdpPacket(payload, len)) return true;
+  FOR_EACH_HOOK(UM_HOOK_UDP, mod) if (mod->onUdpPacket(payload, len)) return true;
   return false;
 }
 void UsermodManager::onUpdateBegin(bool init) { for (auto mod = _usermod_table_begin; mod < _usermod_table_end; ++mod) (*mod)->onUpdateBegin(init); } // notify usermods that update is to begin
-void UsermodManager::onStateChange(uint8_t mode) { for (auto mod = _usermod_table_begin; mod < _usermod_table_end; ++mod) (*mod)->onStateChange(mode); } // notify usermods that WLED state changed
+void UsermodManager::onStateChange(uint8_t mode) { FOR_EACH_HOOK(UM_HOOK_STATE_CHANGE, mod) mod->onStateChange(mode); } // notify usermods that WLED state changed
 
 /*
  * Enables usermods to lookup another Usermod.
@@ -88,6 +148,7 @@ Usermod* UsermodManager::lookup(uint16_t mod_id) {
 }
 
 size_t UsermodManager::getModCount() { return getCount(); };
+Usermod* UsermodManager::getMod(size_t index) { return index < getCount() ? _usermod_table_begin[index] : nullptr; }
 
 /* Usermod v2 interface shim for oappend */
 Print* Usermod::oappend_shim = nullptr;
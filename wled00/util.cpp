@@ -160,6 +160,24 @@ bool isAsterisksOnly(const char* str, byte maxLen)
 }
 
 
+// JSON buffer lock statistics per module ID (last slot collects all IDs that do not fit, i.e. usermods)
+#define JSON_LOCK_STATS_SLOTS 28
+typedef struct JsonLockStats {
+  uint32_t locks;     // successful requests
+  uint32_t waitTotal; // ms spent waiting for the lock
+  uint16_t fails;     // failed requests (timeout or buffer busy)
+  uint16_t maxWait;   // ms
+} json_lock_stats_t;
+static json_lock_stats_t jsonLockStats[JSON_LOCK_STATS_SLOTS];
+
+static void updateJSONLockStats(uint8_t moduleID, bool locked, unsigned long waited) {
+  json_lock_stats_t &s = jsonLockStats[moduleID < JSON_LOCK_STATS_SLOTS-1 ? moduleID : JSON_LOCK_STATS_SLOTS-1];
+  if (locked) s.locks++;
+  else if (s.fails < UINT16_MAX) s.fails++;
+  s.waitTotal += waited;
+  if (waited > s.maxWait) s.maxWait = min(waited, (unsigned long)UINT16_MAX);
+}
+
 //threading/network callback details: https://github.com/wled-dev/WLED/pull/2336#discussion_r762276994
 bool requestJSONBufferLock(uint8_t moduleID)
 {
@@ -167,12 +185,16 @@ bool requestJSONBufferLock(uint8_t moduleID)
     DEBUG_PRINTLN(F("ERROR: JSON buffer not allocated!"));
     return false;
   }
+  const unsigned long start = millis();
 
 #if defined(ARDUINO_ARCH_ESP32)
   // Use a recursive mutex type in case our task is the one holding the JSON buffer.
   // This can happen during large JSON web transactions.  In this case, we continue immediately
   // and then will return out below if the lock is still held.
-  if (xSemaphoreTakeRecursive(jsonBufferLockMutex, 250) == pdFALSE) return false;  // timed out waiting
+  if (xSemaphoreTakeRecursive(jsonBufferLockMutex, 250) == pdFALSE) {  // timed out waiting
+    updateJSONLockStats(moduleID, false, millis() - start);
+    return false;
+  }
 #elif defined(ARDUINO_ARCH_ESP8266)
   // If we're in system context, delay() won't return control to the user context, so there's
   // no point in waiting.
@@ -189,12 +211,14 @@ bool requestJSONBufferLock(uint8_t moduleID)
 #ifdef ARDUINO_ARCH_ESP32
     xSemaphoreGiveRecursive(jsonBufferLockMutex);
 #endif
+    updateJSONLockStats(moduleID, false, millis() - start);
     return false;
   }
 
   jsonBufferLock = moduleID ? moduleID : 255;
   DEBUG_PRINTF_P(PSTR("JSON buffer locked. (%d)\n"), jsonBufferLock);
   pDoc->clear();
+  updateJSONLockStats(moduleID, true, millis() - start);
   return true;
 }
 
@@ -208,6 +232,84 @@ void releaseJSONBufferLock()
 #endif  
 }
 
+/*
+ * Pool of additional JSON documents for serializers of static data (effect, palette and fxdata lists, networks, perf),
+ * so they do not block (or get blocked by) writers using the global pDoc.
+ * Pool documents are handed out without the global lock: data a writer holding pDoc may change (state, segments, info,
+ * nodes, config) must not be serialized into them, use requestJSONBufferLock() for that.
+ * Documents are allocated on first use and kept (in PSRAM if available, without PSRAM only if there is enough heap),
+ * so the heap is not fragmented by allocating and freeing large documents.
+ * If no pool document is available the global buffer is used (requestJSONBufferLock()).
+ */
+#if WLED_JSON_POOL_SIZE > 0
+static JsonDocument *jsonPool[WLED_JSON_POOL_SIZE] = {nullptr};
+static volatile uint8_t jsonPoolOwner[WLED_JSON_POOL_SIZE] = {0};
+static portMUX_TYPE jsonPoolMux = portMUX_INITIALIZER_UNLOCKED;
+#endif
+
+JsonDocument *requestJSONDocument(uint8_t moduleID)
+{
+#if WLED_JSON_POOL_SIZE > 0
+  int slot = -1;
+  portENTER_CRITICAL(&jsonPoolMux);
+  for (int i = 0; i < WLED_JSON_POOL_SIZE; i++) {
+    if (!jsonPoolOwner[i]) { jsonPoolOwner[i] = moduleID ? moduleID : 255; slot = i; break; }
+  }
+  portEXIT_CRITICAL(&jsonPoolMux);
+  if (slot >= 0) {
+    #ifndef BOARD_HAS_PSRAM
+    if (!jsonPool[slot] && getContiguousFreeHeap() > JSON_BUFFER_SIZE + 2*MIN_HEAP_SIZE)
+    #else
+    if (!jsonPool[slot])
+    #endif
+      jsonPool[slot] = new(std::nothrow) PSRAMDynamicJsonDocument(JSON_BUFFER_SIZE);
+    if (jsonPool[slot] && jsonPool[slot]->capacity()) {
+      jsonPool[slot]->clear();
+      updateJSONLockStats(moduleID, true, 0);
+      DEBUG_PRINTF_P(PSTR("JSON pool document %d used. (%d)\n"), slot, moduleID);
+      return jsonPool[slot];
+    }
+    delete jsonPool[slot];
+    jsonPool[slot] = nullptr;
+    jsonPoolOwner[slot] = 0;
+  }
+#endif
+  return requestJSONBufferLock(moduleID) ? pDoc : nullptr;
+}
+
+void releaseJSONDocument(JsonDocument *doc)
+{
+  if (!doc) return;
+  if (doc == pDoc) {
+    releaseJSONBufferLock();
+    return;
+  }
+#if WLED_JSON_POOL_SIZE > 0
+  for (int i = 0; i < WLED_JSON_POOL_SIZE; i++) {
+    if (jsonPool[i] != doc) continue;
+    jsonPoolOwner[i] = 0; // document is kept for the next request
+    return;
+  }
+#endif
+}
+
+void serializeJSONLockStats(JsonObject root)
+{
+  JsonObject jl = root.createNestedObject(F("jlock"));
+  jl[F("pool")] = WLED_JSON_POOL_SIZE;
+  JsonArray mods = jl.createNestedArray(F("mod")); // [module ID, locks, fails, avg. wait ms, max. wait ms]
+  for (unsigned i = 0; i < JSON_LOCK_STATS_SLOTS; i++) {
+    const json_lock_stats_t &s = jsonLockStats[i];
+    if (!s.locks && !s.fails) continue;
+    JsonArray m = mods.createNestedArray();
+    m.add(i < JSON_LOCK_STATS_SLOTS-1 ? i : 255);
+    m.add(s.locks);
+    m.add(s.fails);
+    m.add(s.waitTotal / (s.locks + s.fails));
+    m.add(s.maxWait);
+  }
+}
+
 
 // extracts effect mode (or palette) name from names serialized string
 // caller must provide large enough buffer for name (including SR extensions)!
@@ -613,6 +715,12 @@ uint32_t hashInt(uint32_t s) {
   return (s >> 16) ^ s;
 }
 
+// FNV-1a, pass the result as hash to continue hashing over multiple buffers
+uint32_t hashBuffer(const uint8_t *data, size_t len, uint32_t hash) {
+  while (len--) hash = (hash ^ *data++) * 16777619UL;
+  return hash;
+}
+
 // 32 bit random number generator, inlining uses more code, use hw_random16() if speed is critical (see fcn_declare.h)
 uint32_t hw_random(uint32_t upperlimit) {
   uint32_t rnd = hw_random();
@@ -18,6 +18,15 @@ extern "C" void usePWMFixedNMI();
  * Main WLED class implementation. Mostly initialization and connection logic
  */
 
+static int nodeListJob = -1;
+
+// refresh WLED nodes list and announce this node (background job)
+static void updateNodeList(void *)
+{
+  refreshNodeList();
+  if (nodeBroadcastEnabled) sendSysInfoUDP();
+}
+
 WLED::WLED()
 {
 }
@@ -42,6 +51,8 @@ void WLED::loop()
 {
   static uint32_t      lastHeap = UINT32_MAX;
   static unsigned long heapTime = 0;
+  const unsigned long  perfLoop = micros();
+  unsigned long        perfStart;
 #ifdef WLED_DEBUG
   static unsigned long lastRun = 0;
   unsigned long        loopMillis = millis();
@@ -66,7 +77,9 @@ void WLED::loop()
   handleSerial();
   #endif
   handleImprovWifiScan();
+  perfStart = micros();
   handleNotifications();
+  perfRecord(PERF_NOTIFY, perfStart);
   handleTransitions();
   #ifdef WLED_ENABLE_DMX
   handleDMXOutput();
@@ -78,8 +91,10 @@ void WLED::loop()
   #ifdef WLED_DEBUG
   unsigned long usermodMillis = millis();
   #endif
+  perfStart = micros();
   userLoop();
   UsermodManager::loop();
+  perfRecord(PERF_USERMODS, perfStart);
   #ifdef WLED_DEBUG
   usermodMillis = millis() - usermodMillis;
   avgUsermodMillis += usermodMillis;
@@ -87,6 +102,7 @@ void WLED::loop()
   #endif
 
   yield();
+  perfStart = micros();
   handleIO();
   #ifndef WLED_DISABLE_INFRARED
   handleIR();
@@ -97,6 +113,7 @@ void WLED::loop()
   #ifndef WLED_DISABLE_ALEXA
   handleAlexa();
   #endif
+  perfRecord(PERF_IO, perfStart);
 
   if (doCloseFile) {
     closeFile();
@@ -126,9 +143,18 @@ void WLED::loop()
     }
     handlePresets();
     yield();
+    #ifdef WLED_ENABLE_PRESET_LOG
+    handlePresetLog();
+    yield();
+    #endif
+    handleJsonCache();
 
-    if (!offMode || strip.isOffRefreshRequired() || strip.needsUpdate())
+    if (!offMode || strip.isOffRefreshRequired() || strip.needsUpdate()) {
+      perfStart = micros();
       strip.service();
+      perfRecord(PERF_STRIP, perfStart);
+      bootPhase(BOOT_FRAME);
+    }
     #ifdef ESP8266
     else if (!noWifiSleep)
       delay(1); //required to make sure ESP enters modem sleep (see #1184)
@@ -140,6 +166,10 @@ void WLED::loop()
   if (stripMillis > maxStripMillis) maxStripMillis = stripMillis;
   #endif
 
+  perfStart = micros();
+  handleJobs(); // background jobs in the time left until the next frame
+  perfRecord(PERF_JOBS, perfStart);
+
   yield();
 #ifdef ESP8266
   MDNS.update();
@@ -158,10 +188,6 @@ void WLED::loop()
     initMqtt();
     #endif
     yield();
-    // refresh WLED nodes list
-    refreshNodeList();
-    if (nodeBroadcastEnabled) sendSysInfoUDP();
-    yield();
   }
 
   // 15min PIN time-out
@@ -204,7 +230,9 @@ void WLED::loop()
   if (configNeedsWrite) serializeConfigToFS();
 
   yield();
+  perfStart = micros();
   handleWs();
+  perfRecord(PERF_WS, perfStart);
 #if defined(STATUSLED)
   handleStatusLED();
 #endif
@@ -224,6 +252,8 @@ void WLED::loop()
   }
 #endif
 
+  perfRecord(PERF_LOOP, perfLoop);
+
   if (doReboot && (!doInitBusses || !configNeedsWrite)) // if busses have to be inited & saved, wait until next iteration
     reset();
 
@@ -339,6 +369,7 @@ void WLED::setup()
   #if defined(ARDUINO_ARCH_ESP32) && defined(WLED_DISABLE_BROWNOUT_DET)
   WRITE_PERI_REG(RTC_CNTL_BROWN_OUT_REG, 0); //disable brownout detection
   #endif
+  traceInit();
 
   #ifdef ARDUINO_ARCH_ESP32
   pinMode(hardwareRX, INPUT_PULLDOWN); delay(1);        // suppress noise in case RX pin is floating (at low noise energy) - see issue #3128
@@ -416,6 +447,7 @@ void WLED::setup()
 #endif
 
   DEBUG_PRINTF_P(PSTR("heap %u\n"), getFreeHeapSize());
+  bootPhase(BOOT_INIT);
 
   bool fsinit = false;
   DEBUGFS_PRINTLN(F("Mount FS"));
@@ -437,6 +469,11 @@ void WLED::setup()
   initPresetsFile();
 #endif
   updateFSInfo();
+  indexPresetsFile();
+  #ifdef WLED_ENABLE_PRESET_LOG
+  initPresetLog();
+  #endif
+  bootPhase(BOOT_FS);
 
   // generate module IDs must be done before AP setup
   escapedMac = WiFi.macAddress();
@@ -454,6 +491,7 @@ void WLED::setup()
   DEBUG_PRINTLN(F("Reading config"));
   bool needsCfgSave = deserializeConfigFromFS();
   DEBUG_PRINTF_P(PSTR("heap %u\n"), getFreeHeapSize());
+  bootPhase(BOOT_CFG);
 
 #if defined(STATUSLED) && STATUSLED>=0
   if (!PinManager::isPinAllocated(STATUSLED)) {
@@ -466,11 +504,16 @@ void WLED::setup()
   DEBUG_PRINTLN(F("Initializing strip"));
   beginStrip();
   DEBUG_PRINTF_P(PSTR("heap %u\n"), getFreeHeapSize());
+  bootPhase(BOOT_STRIP);
+
+  nodeListJob = addJob(updateNodeList, nullptr, 30000, 2000, 5000, PSTR("nodes"));
 
   DEBUG_PRINTLN(F("Usermods setup"));
   userSetup();
   UsermodManager::setup();
+  if (fastStart && bootPreset > 0) applyPresetToUsermods(bootPreset); // usermods were not initialized when beginStrip() applied it
   DEBUG_PRINTF_P(PSTR("heap %u\n"), getFreeHeapSize());
+  bootPhase(BOOT_USERMODS);
 
   if (needsCfgSave) serializeConfigToFS(); // usermods required new parameters; need to wait for strip to be initialised #4752
 
@@ -532,10 +575,13 @@ void WLED::setup()
   if (serialCanRX && Serial.available() > 0 && Serial.peek() == 'I') handleImprovPacket();
 #endif
 
+  bootPhase(BOOT_NETWORK);
+
   // HTTP server page init
   DEBUG_PRINTLN(F("initServer"));
   initServer();
   DEBUG_PRINTF_P(PSTR("heap %u\n"), getFreeHeapSize());
+  bootPhase(BOOT_SERVER);
 
 #ifndef WLED_DISABLE_INFRARED
   // init IR
@@ -555,6 +601,7 @@ void WLED::setup()
   #if defined(ARDUINO_ARCH_ESP32) && defined(WLED_DISABLE_BROWNOUT_DET)
   WRITE_PERI_REG(RTC_CNTL_BROWN_OUT_REG, 1); //enable brownout detector
   #endif
+  bootPhase(BOOT_SETUP);
 }
 
 void WLED::beginStrip()
@@ -588,6 +635,9 @@ void WLED::beginStrip()
   if (bootPreset > 0) {
     applyPreset(bootPreset, CALL_MODE_INIT);
   }
+  // fast start: apply the boot preset now (without transition) instead of in the first loop() after network and web server init
+  // usermods are not set up yet and ignore the preset, it is passed to them again after UsermodManager::setup()
+  if (fastStart && bootPreset > 0) handlePresets();
 
   strip.setTransition(transitionDelayDefault);  // restore transitions
 
@@ -596,6 +646,11 @@ void WLED::beginStrip()
     pinMode(rlyPin, rlyOpenDrain ? OUTPUT_OPEN_DRAIN : OUTPUT);
     digitalWrite(rlyPin, (rlyMde ? bri : !bri));
   }
+
+  if (fastStart) {
+    strip.service(); // first frame
+    bootPhase(BOOT_FRAME);
+  }
 }
 
 void WLED::initAP(bool resetAP)
@@ -872,9 +927,11 @@ void WLED::handleConnection()
       if (improvActive > 1) sendImprovIPRPCResult(ImprovRPCType::Command_Wifi);
     }
     initInterfaces();
+    bootPhase(BOOT_CONNECTED);
     userConnected();
     UsermodManager::connected();
     lastMqttReconnectAttempt = 0; // force immediate update
+    triggerJob(nodeListJob);
 
     // shut down AP
     if (apBehavior != AP_BEHAVIOR_ALWAYS && apActive) {
@@ -72,6 +72,7 @@
 
 #include <cstddef>
 #include <vector>
+#include <memory>
 
 // Library inclusions.
 #include <Arduino.h>
@@ -197,6 +198,7 @@ using PSRAMDynamicJsonDocument = BasicJsonDocument<PSRAM_Allocator>;
 #include "colors.h"
 #include "bus_manager.h"
 #include "FX.h"
+#include "display_fb.h"
 #include "wled_metadata.h"
 
 #ifndef CLIENT_SSID
@@ -394,6 +396,7 @@ WLED_GLOBAL uint8_t txPower _INIT(WIFI_POWER_19_5dBm);
 
 // LED CONFIG
 WLED_GLOBAL bool turnOnAtBoot _INIT(true);                // turn on LEDs at power-up
+WLED_GLOBAL bool fastStart    _INIT(false);               // apply boot preset and show first frame before usermods and network are set up
 WLED_GLOBAL byte bootPreset   _INIT(0);                   // save preset to load after power-up
 
 //if true, a segment per bus will be created on boot and LED settings save
@@ -489,6 +492,8 @@ WLED_GLOBAL uint16_t DMXSegmentSpacing _INIT(0);                  // Number of v
 WLED_GLOBAL byte e131LastSequenceNumber[E131_MAX_UNIVERSE_COUNT]; // to detect packet loss
 WLED_GLOBAL bool e131Multicast _INIT(false);                      // multicast or unicast
 WLED_GLOBAL bool e131SkipOutOfSequence _INIT(false);              // freeze instead of flickering
+WLED_GLOBAL uint16_t ddpJitterMs _INIT(0);                        // DDP jitter buffer latency in ms (0 = disabled, frames are shown on arrival)
+WLED_GLOBAL ddp_jitter_stats_t ddpStats _INIT_N(({0, 0, 0, 0}));  // DDP jitter buffer counters
 WLED_GLOBAL uint16_t pollReplyCount _INIT(0);                     // count number of replies for ArtPoll node report
 
 // mqtt
@@ -655,6 +660,7 @@ WLED_GLOBAL bool sendNotificationsRT  _INIT(false);           // master notifica
 WLED_GLOBAL unsigned long notificationSentTime _INIT(0);
 WLED_GLOBAL byte notificationSentCallMode _INIT(CALL_MODE_INIT);
 WLED_GLOBAL uint8_t notificationCount _INIT(0);
+WLED_GLOBAL uint16_t notifyWindow _INIT(20);                  // ms, changes within this time are merged into one sync notification
 WLED_GLOBAL uint8_t syncGroups    _INIT(0x01);                // sync send groups this instance syncs to (bit mapped)
 WLED_GLOBAL uint8_t receiveGroups _INIT(0x01);                // sync receive groups this instance belongs to (bit mapped)
 #ifdef WLED_SAVE_RAM
@@ -836,6 +842,8 @@ WLED_GLOBAL bool realtimeRespectLedMaps _INIT(true);                     // Resp
 
 WLED_GLOBAL unsigned long lastInterfaceUpdate _INIT(0);
 WLED_GLOBAL byte interfaceUpdateCallMode _INIT(CALL_MODE_INIT);
+WLED_GLOBAL bool     stateUpdatePending _INIT(false);                    // stateUpdated() deferred to the main loop (fast JSON state updates)
+WLED_GLOBAL uint32_t stateGeneration _INIT(0);                           // incremented on every state change, outdates JSON snapshots
 
 // alexa udp
 WLED_GLOBAL String escapedMac;
@@ -908,6 +916,7 @@ WLED_GLOBAL WiFiUDP ntpUdp;
 WLED_GLOBAL ESPAsyncE131 e131 _INIT_N(((handleE131Packet)));
 WLED_GLOBAL ESPAsyncE131 ddp  _INIT_N(((handleE131Packet)));
 WLED_GLOBAL bool e131NewData _INIT(false);
+WLED_GLOBAL bool e131SyncFrame _INIT(false);   // new data was completed by E1.31 sync or ArtSync packet (show without delay)
 
 // led fx library object
 WLED_GLOBAL WS2812FX   strip         _INIT(WS2812FX());
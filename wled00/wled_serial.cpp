@@ -176,8 +176,10 @@ void handleSerial()
         if (--count > 0) state = AdaState::Data_Red;
         else {
           realtimeLock(realtimeTimeoutMs, REALTIME_MODE_ADALIGHT);
+          rtStatsPacket(REALTIME_MODE_ADALIGHT, 0, pixel * 3);
+          rtStatsFrame(REALTIME_MODE_ADALIGHT);
 
-          if (!realtimeOverride) strip.show();
+          if (!realtimeOverride) { strip.show(); rtStatsShown(); }
           state = AdaState::Header_A;
         }
         break;
@@ -204,6 +204,7 @@ static void handleUpload(AsyncWebServerRequest *request, const String& filename,
   if (isFinal) {
     request->_tempFile.close();
     if (filename.indexOf(F("cfg.json")) >= 0) { // check for filename with or without slash
+      invalidateConfigSnapshot();
       doReboot = true;
       request->send(200, FPSTR(CONTENT_TYPE_PLAIN), F("Config restore ok.\nRebooting..."));
     } else {
@@ -387,12 +388,19 @@ void initServer()
     bool verboseResponse = false;
     bool isConfig = false;
 
+    // small state updates (i.e. slider drags) are applied without the JSON buffer
+    if (!isMsgPackBody(request) && request->url().indexOf(F("cfg")) < 0 && deserializeStateFast((const char*)request->_tempObject, request->contentLength())) {
+      serveJsonSuccess(request);
+      return;
+    }
+
     if (!requestJSONBufferLock(14)) {
       request->deferResponse();
       return;
     }
 
-    DeserializationError error = deserializeJson(*pDoc, (uint8_t*)(request->_tempObject));
+    DeserializationError error = isMsgPackBody(request) ? deserializeMsgPack(*pDoc, (uint8_t*)(request->_tempObject), request->contentLength())
+                                                        : deserializeJson(*pDoc, (uint8_t*)(request->_tempObject));
     JsonObject root = pDoc->as<JsonObject>();
     if (error || root.isNull()) {
       releaseJSONBufferLock();
@@ -436,7 +444,7 @@ void initServer()
         configNeedsWrite = true; //Save new settings to FS
       }
     }
-    request->send(200, CONTENT_TYPE_JSON, F("{\"success\":true}"));
+    serveJsonSuccess(request);
   }, JSON_BUFFER_SIZE);
   server.addHandler(handler);
 
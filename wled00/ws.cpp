@@ -10,15 +10,159 @@ constexpr uint8_t BINARY_PROTOCOL_GENERIC = 0xFF; // generic / auto detect NOT I
 constexpr uint8_t BINARY_PROTOCOL_E131    = P_E131; // = 0, untested!
 constexpr uint8_t BINARY_PROTOCOL_ARTNET  = P_ARTNET; // = 1, untested!
 constexpr uint8_t BINARY_PROTOCOL_DDP     = P_DDP; // = 2
+constexpr uint8_t BINARY_PROTOCOL_PIXELS  = 3; // raw pixel data, see handleWsPixels()
+constexpr uint8_t BINARY_PROTOCOL_MSGPACK = 4; // JSON API encoded as MessagePack, replies use the same protocol byte
+
+// raw pixel protocol header (following the protocol byte)
+// byte 0: timeout in seconds (0: exit realtime mode immediately, 255: no timeout), same as UDP realtime
+// byte 1: flags, see below
+// byte 2-3: index of first LED (big endian)
+// followed by 3 (RGB) or 4 (RGBW) bytes per LED
+constexpr size_t  WS_PIXELS_HEADER_LEN    = 4;
+constexpr uint8_t WS_PIXELS_FLAG_RGBW     = 0x01; // data is RGBW
+constexpr uint8_t WS_PIXELS_FLAG_MORE     = 0x02; // frame continues in next message, do not show yet
 
 uint16_t wsLiveClientId = 0;
 unsigned long wsLastLiveTime = 0;
 //uint8_t* wsFrameBuffer = nullptr;
 
 #define WS_LIVE_INTERVAL 40
+#define WS_LIVE_MAX_INTERVAL 400 // slowest live view frame rate if client cannot keep up
+
+/*
+ * Live view version 3 (requested with {"lv":3}): delta and run length encoded frames
+ * header: 'L', 3, flags (bit 0: key frame, bit 1: 2D), step (decimation), width (BE16), height (BE16)
+ * followed by ops, run length is (op & 0x3F) + 1 pixels:
+ * 00xxxxxx skip (pixels unchanged since previous frame, not used in key frames)
+ * 01xxxxxx repeat following RGB color
+ * 10xxxxxx literal, followed by RGB of each pixel
+ * 11xxxxxx single pixel with color from index table (index = (r*3 + g*5 + b*7) % 64, updated by repeat and literal ops, cleared every frame)
+ * Frame rate and decimation adapt to the WebSocket queue of the client.
+ */
+#define LIVE_V3_HEADER_LEN 8
+#define LIVE_OP_SKIP    0x00
+#define LIVE_OP_REPEAT  0x40
+#define LIVE_OP_LITERAL 0x80
+#define LIVE_OP_INDEX   0xC0
+#define LIVE_RUN_MAX    64
+#ifdef ESP8266
+  #define MAX_LIVE_LEDS_V3 1024U
+#else
+  #define MAX_LIVE_LEDS_V3 4096U
+#endif
+
+static uint8_t  wsLiveVersion = 1;
+static volatile bool wsLiveReset = true;  // set from async context, live view state is reset in main loop
+static uint8_t *wsLivePrev = nullptr;     // last frame sent (RGB)
+static uint8_t *wsLiveCur  = nullptr;
+static size_t   wsLiveCount = 0;          // pixels in wsLivePrev/wsLiveCur
+static bool     wsLiveKey = true;         // next frame must be a key frame
+static uint8_t  wsLiveStep = 1;
+static uint8_t  wsLiveMinStep = 1;
+static uint16_t wsLiveInterval = WS_LIVE_INTERVAL;
+static uint8_t  wsLiveBusy = 0, wsLiveIdle = 0;
+
+// binary realtime pixel input, bypasses JSON parsing and buffer lock
+// pixels are shown from the main loop (like E1.31/DDP) as this runs in the async TCP context
+static void handleWsPixels(AsyncWebSocketClient * client, const uint8_t *data, size_t len)
+{
+  if (!receiveDirect || len < WS_PIXELS_HEADER_LEN) return;
+  if (data[0] == 0) {
+    realtimeTimeout = 0; // cancel realtime mode immediately
+    return;
+  }
+  const bool isRGBW = data[1] & WS_PIXELS_FLAG_RGBW;
+  const unsigned start = (data[2] << 8) | data[3];
+  const unsigned count = (len - WS_PIXELS_HEADER_LEN) / (isRGBW ? 4 : 3);
+
+  realtimeIP = client->remoteIP();
+  realtimeLock(data[0]*1000 +1, REALTIME_MODE_WS);
+  rtStatsPacket(REALTIME_MODE_WS, 0, len);
+  const bool frameComplete = !(data[1] & WS_PIXELS_FLAG_MORE);
+  if (frameComplete) rtStatsFrame(REALTIME_MODE_WS);
+  if (realtimeOverride) return;
+
+  setRealtimePixels(start, &data[WS_PIXELS_HEADER_LEN], count, isRGBW);
+  if (frameComplete) e131NewData = true;
+}
+
+// reply state and info as MessagePack (binary message prefixed with protocol byte)
+static void sendDataWsMsgPack(AsyncWebSocketClient * client)
+{
+  if (!requestJSONBufferLock(12)) {
+    static const uint8_t noBuf[] PROGMEM = {BINARY_PROTOCOL_MSGPACK, 0x81, 0xA5, 'e','r','r','o','r', ERR_NOBUF}; // {"error":3}
+    client->binary(FPSTR(noBuf), sizeof(noBuf));
+    return;
+  }
+  JsonObject state = pDoc->createNestedObject("state");
+  serializeState(state);
+  JsonObject info  = pDoc->createNestedObject("info");
+  serializeInfo(info);
+  prepareMsgPack(pDoc->as<JsonVariant>());
+
+  size_t len = measureMsgPack(*pDoc);
+  AsyncWebSocketBuffer buffer(len + 1);
+  if (buffer) {
+    buffer.data()[0] = BINARY_PROTOCOL_MSGPACK;
+    serializeMsgPack(*pDoc, (uint8_t *)buffer.data() + 1, len);
+    client->binary(std::move(buffer));
+  }
+  releaseJSONBufferLock();
+}
+
+// JSON API request received as JSON text or as MessagePack (same semantics)
+static void handleWsState(AsyncWebSocketClient * client, const uint8_t *data, size_t len, bool msgPack)
+{
+  static const uint8_t msgPackSuccess[] PROGMEM = {BINARY_PROTOCOL_MSGPACK, 0x81, 0xA7, 's','u','c','c','e','s','s', 0xC3}; // {"success":true}
+  bool verboseResponse = false;
+  // small state updates (i.e. slider drags) are applied without the JSON buffer
+  if (msgPack || !deserializeStateFast((const char*)data, len)) {
+    if (!requestJSONBufferLock(11)) {
+      client->text(F("{\"error\":3}")); // ERR_NOBUF
+      return;
+    }
+
+    DeserializationError error = msgPack ? deserializeMsgPack(*pDoc, data, len) : deserializeJson(*pDoc, data, len);
+    JsonObject root = pDoc->as<JsonObject>();
+    if (error || root.isNull()) {
+      releaseJSONBufferLock();
+      return;
+    }
+    if (root["v"] && root.size() == 1) {
+      //if the received value is just "{"v":true}", send only to this client
+      verboseResponse = true;
+    } else if (root.containsKey("lv")) {
+      wsLiveClientId = root["lv"] ? client->id() : 0;
+      wsLiveVersion = root["lv"] == 3 ? 3 : 1;
+      wsLiveReset = true;
+    } else {
+      verboseResponse = deserializeState(root);
+    }
+    releaseJSONBufferLock();
+  }
+
+  if (!interfaceUpdateCallMode) { // individual client response only needed if no WS broadcast soon
+    if (verboseResponse) {
+      #ifndef WLED_DISABLE_MQTT
+      // publish state to MQTT as requested in wled#4643 even if only WS response selected
+      publishMqtt();
+      #endif
+      if (msgPack) sendDataWsMsgPack(client);
+      else         sendDataWs(client);
+    } else {
+      // we have to send something back otherwise WS connection closes
+      if (msgPack) client->binary(FPSTR(msgPackSuccess), sizeof(msgPackSuccess));
+      else         client->text(F("{\"success\":true}"));
+    }
+    // force broadcast in 500ms after updating client
+    //lastInterfaceUpdate = millis() - (INTERFACE_UPDATE_COOLDOWN -500); // ESP8266 does not like this
+  }
+}
 
 void wsEvent(AsyncWebSocket * server, AsyncWebSocketClient * client, AwsEventType type, void * arg, uint8_t *data, size_t len)
 {
+  PerfScope perf(PERF_WS_EVENT);
+  TraceScope trace(TRACE_WS_EVENT, type);
   if(type == WS_EVT_CONNECT){
     //client connected
     DEBUG_PRINTLN(F("WS client connected."));
@@ -41,42 +185,7 @@ void wsEvent(AsyncWebSocket * server, AsyncWebSocketClient * client, AwsEventTyp
           return;
         }
 
-        bool verboseResponse = false;
-        if (!requestJSONBufferLock(11)) {
-          client->text(F("{\"error\":3}")); // ERR_NOBUF
-          return;
-        }
-
-        DeserializationError error = deserializeJson(*pDoc, data, len);
-        JsonObject root = pDoc->as<JsonObject>();
-        if (error || root.isNull()) {
-          releaseJSONBufferLock();
-          return;
-        }
-        if (root["v"] && root.size() == 1) {
-          //if the received value is just "{"v":true}", send only to this client
-          verboseResponse = true;
-        } else if (root.containsKey("lv")) {
-          wsLiveClientId = root["lv"] ? client->id() : 0;
-        } else {
-          verboseResponse = deserializeState(root);
-        }
-        releaseJSONBufferLock();
-
-        if (!interfaceUpdateCallMode) { // individual client response only needed if no WS broadcast soon
-          if (verboseResponse) {
-            #ifndef WLED_DISABLE_MQTT
-            // publish state to MQTT as requested in wled#4643 even if only WS response selected
-            publishMqtt();
-            #endif
-            sendDataWs(client);
-          } else {
-            // we have to send something back otherwise WS connection closes
-            client->text(F("{\"success\":true}"));
-          }
-          // force broadcast in 500ms after updating client
-          //lastInterfaceUpdate = millis() - (INTERFACE_UPDATE_COOLDOWN -500); // ESP8266 does not like this
-        }
+        handleWsState(client, data, len, false);
       }else if (info->opcode == WS_BINARY) {
         // first byte determines protocol. Note: since e131_packet_t is "packed", the compiler handles alignment issues
         //DEBUG_PRINTF_P(PSTR("WS binary message: len %u, byte0: %u\n"), len, data[0]);
@@ -88,6 +197,12 @@ void wsEvent(AsyncWebSocket * server, AsyncWebSocketClient * client, AwsEventTyp
           case BINARY_PROTOCOL_ARTNET:
             handleE131Packet((e131_packet_t*)&data[offset], client->remoteIP(), P_ARTNET);
             break;
+          case BINARY_PROTOCOL_PIXELS:
+            handleWsPixels(client, &data[offset], len - offset);
+            break;
+          case BINARY_PROTOCOL_MSGPACK:
+            handleWsState(client, &data[offset], len - offset, true);
+            break;
           case BINARY_PROTOCOL_DDP:
             if (len < 10 + offset) return; // DDP header is 10 bytes (+1 protocol byte)
             size_t ddpDataLen = (data[8+offset] << 8) | data[9+offset]; // data length in bytes from DDP header
@@ -132,11 +247,29 @@ void wsEvent(AsyncWebSocket * server, AsyncWebSocketClient * client, AwsEventTyp
   }
 }
 
+// send shared state+info snapshot (no JSON document needed, serialized once for all clients and HTTP pollers)
+static bool sendDataWsSnapshot(AsyncWebSocketClient * client)
+{
+  json_snapshot_ptr snap = getJsonSnapshot(true);
+  if (!snap) return false;
+  #ifdef ESP8266
+  if (snap->len > getFreeHeapSize()) return false;
+  #endif
+  AsyncWebSocketBuffer buffer(snap->len);
+  if (!buffer) return false;
+  memcpy(buffer.data(), snap->data, snap->len);
+  DEBUG_PRINTF_P(PSTR("Sending WS snapshot (%u).\n"), snap->len);
+  if (client) client->text(std::move(buffer));
+  else        ws.textAll(std::move(buffer)); // one buffer shared by all clients
+  return true;
+}
+
 void sendDataWs(AsyncWebSocketClient * client)
 {
   if (!ws.count()) return;
+  if (sendDataWsSnapshot(client)) return;
 
-  if (!requestJSONBufferLock(12)) {
+  if (!requestJSONBufferLock(12)) { // state is not static, no pool document (see requestJSONDocument())
     const char* error = PSTR("{\"error\":3}");
     if (client) {
       client->text(FPSTR(error)); // ERR_NOBUF
@@ -160,6 +293,7 @@ void sendDataWs(AsyncWebSocketClient * client)
   #ifdef ESP8266
   if (len>heap1) {
     DEBUG_PRINTLN(F("Out of memory (WS)!"));
+    releaseJSONBufferLock();
     return;
   }
   #endif
@@ -191,9 +325,146 @@ void sendDataWs(AsyncWebSocketClient * client)
   releaseJSONBufferLock();
 }
 
+// RGB of live view pixel, white channel added to RGB as a simple RGBW -> RGB map
+static inline void getLivePixel(uint8_t *dst, unsigned i)
+{
+  uint32_t c = strip.getPixelColor(i);
+  uint8_t w = W(c);
+  dst[0] = bri ? qadd8(w, R(c)) : 0;
+  dst[1] = bri ? qadd8(w, G(c)) : 0;
+  dst[2] = bri ? qadd8(w, B(c)) : 0;
+}
+
+// encodes cur (count RGB pixels) against prev (nullptr for key frame), returns length; out may be nullptr to measure
+static size_t encodeLiveFrame(uint8_t *out, const uint8_t *cur, const uint8_t *prev, size_t count)
+{
+  uint32_t index[64] = {0};
+  size_t pos = 0, litPos = 0;
+  unsigned litCount = 0;
+  for (size_t i = 0; i < count; ) {
+    const uint8_t *c = &cur[i*3];
+    size_t run = 0;
+    if (prev) {
+      while (i + run < count && run < LIVE_RUN_MAX && !memcmp(&cur[(i+run)*3], &prev[(i+run)*3], 3)) run++;
+      if (run) {
+        if (out) out[pos] = LIVE_OP_SKIP | (run-1);
+        pos++; i += run; litCount = 0;
+        continue;
+      }
+    }
+    run = 1;
+    while (i + run < count && run < LIVE_RUN_MAX && !memcmp(&cur[(i+run)*3], c, 3)) run++;
+    const uint32_t col = RGBW32(c[0], c[1], c[2], 0);
+    const unsigned h = (c[0]*3 + c[1]*5 + c[2]*7) % 64;
+    if (run > 1) {
+      if (out) { out[pos] = LIVE_OP_REPEAT | (run-1); memcpy(&out[pos+1], c, 3); }
+      pos += 4; i += run; litCount = 0;
+      index[h] = col;
+      continue;
+    }
+    if (index[h] == col) {
+      if (out) out[pos] = LIVE_OP_INDEX | h;
+      pos++; i++; litCount = 0;
+      continue;
+    }
+    if (litCount == 0 || litCount == LIVE_RUN_MAX) { litPos = pos++; litCount = 0; } // start new literal run
+    if (out) { out[litPos] = LIVE_OP_LITERAL | litCount; memcpy(&out[pos], c, 3); }
+    pos += 3; i++; litCount++;
+    index[h] = col;
+  }
+  return pos;
+}
+
+static void freeLiveV3()
+{
+  p_free(wsLivePrev); wsLivePrev = nullptr;
+  p_free(wsLiveCur);  wsLiveCur  = nullptr;
+  wsLiveCount = 0;
+}
+
+// adapt frame rate and decimation to the client's WebSocket queue
+static void adaptLiveV3(bool busy)
+{
+  if (busy) {
+    wsLiveIdle = 0;
+    if (++wsLiveBusy < 3) return;
+    wsLiveBusy = 0;
+    if (wsLiveInterval < WS_LIVE_MAX_INTERVAL) wsLiveInterval = min(wsLiveInterval * 3 / 2, WS_LIVE_MAX_INTERVAL);
+    else if (wsLiveStep < 8) { wsLiveStep *= 2; wsLiveKey = true; }
+  } else {
+    wsLiveBusy = 0;
+    if (++wsLiveIdle < 50) return;
+    wsLiveIdle = 0;
+    if (wsLiveStep > wsLiveMinStep) { wsLiveStep /= 2; wsLiveKey = true; }
+    else if (wsLiveInterval > WS_LIVE_INTERVAL) wsLiveInterval = max(wsLiveInterval * 3 / 4, WS_LIVE_INTERVAL);
+  }
+}
+
+static bool sendLiveLedsWsV3(AsyncWebSocketClient * wsc)
+{
+  if (wsLiveReset) {
+    wsLiveReset = false;
+    freeLiveV3();
+    wsLiveKey = true;
+    wsLiveInterval = WS_LIVE_INTERVAL;
+    wsLiveBusy = wsLiveIdle = 0;
+    wsLiveMinStep = 0; // recalculate
+  }
+  if (wsc->queueLength() > 0) { adaptLiveV3(true); return false; }
+
+  unsigned width = strip.getLengthTotal(), height = 1;
+  bool is2D = false;
+#ifndef WLED_DISABLE_2D
+  if (strip.isMatrix) { width = Segment::maxWidth; height = Segment::maxHeight; is2D = true; }
+#endif
+  if (!wsLiveMinStep) { // smallest decimation within pixel limit
+    wsLiveMinStep = 1;
+    while ((width/wsLiveMinStep) * (is2D ? height/wsLiveMinStep : 1) > MAX_LIVE_LEDS_V3) wsLiveMinStep *= 2;
+    wsLiveStep = wsLiveMinStep;
+  }
+  const unsigned step = wsLiveStep;
+  const unsigned w = width / step, h = is2D ? height / step : 1;
+  const size_t count = w * h;
+  if (!count) return true;
+
+  if (count != wsLiveCount) { // size changed (or first frame)
+    freeLiveV3();
+    wsLivePrev = static_cast<uint8_t*>(p_malloc(count * 3));
+    wsLiveCur  = static_cast<uint8_t*>(p_malloc(count * 3));
+    if (!wsLivePrev || !wsLiveCur) { freeLiveV3(); return false; }
+    wsLiveCount = count;
+    wsLiveKey = true;
+  }
+  for (size_t y = 0, p = 0; y < h; y++) for (size_t x = 0; x < w; x++, p += 3) {
+    getLivePixel(&wsLiveCur[p], is2D ? y*step*width + x*step : x*step);
+  }
+
+  const uint8_t *prev = wsLiveKey ? nullptr : wsLivePrev;
+  if (prev && !memcmp(wsLiveCur, prev, count * 3)) { adaptLiveV3(false); return true; } // unchanged, nothing to send
+  size_t len = encodeLiveFrame(nullptr, wsLiveCur, prev, count);
+
+  AsyncWebSocketBuffer wsBuf(LIVE_V3_HEADER_LEN + len);
+  if (!wsBuf) return false; //out of memory
+  uint8_t* buffer = reinterpret_cast<uint8_t*>(wsBuf.data());
+  buffer[0] = 'L';
+  buffer[1] = 3; //version
+  buffer[2] = (prev ? 0 : 0x01) | (is2D ? 0x02 : 0);
+  buffer[3] = step;
+  buffer[4] = w >> 8; buffer[5] = w;
+  buffer[6] = h >> 8; buffer[7] = h;
+  encodeLiveFrame(buffer + LIVE_V3_HEADER_LEN, wsLiveCur, prev, count);
+  wsc->binary(std::move(wsBuf));
+
+  std::swap(wsLivePrev, wsLiveCur);
+  wsLiveKey = false;
+  adaptLiveV3(false);
+  return true;
+}
+
 bool sendLiveLedsWs(uint32_t wsClient)
 {
   AsyncWebSocketClient * wsc = ws.client(wsClient);
+  if (wsc && wsLiveVersion == 3) return sendLiveLedsWsV3(wsc);
   if (!wsc || wsc->queueLength() > 0) return false; //only send if queue free
 
   size_t used = strip.getLengthTotal();
@@ -252,7 +523,7 @@ bool sendLiveLedsWs(uint32_t wsClient)
 
 void handleWs()
 {
-  if (millis() - wsLastLiveTime > WS_LIVE_INTERVAL)
+  if (millis() - wsLastLiveTime > (wsLiveVersion == 3 ? wsLiveInterval : WS_LIVE_INTERVAL))
   {
     #ifdef ESP8266
     ws.cleanupClients(3);
@@ -261,6 +532,7 @@ void handleWs()
     #endif
     bool success = true;
     if (wsLiveClientId) success = sendLiveLedsWs(wsLiveClientId);
+    else if (wsLiveCount) freeLiveV3(); // live view closed
     wsLastLiveTime = millis();
     if (!success) wsLastLiveTime -= 20; //try again in 20ms if failed due to non-empty WS queue
   }
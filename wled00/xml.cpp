@@ -387,6 +387,7 @@ void getSettingsJS(byte subPage, Print& settingsScript)
     printSetFormValue(settingsScript,PSTR("CA"),briS);
 
     printSetFormCheckbox(settingsScript,PSTR("BO"),turnOnAtBoot);
+    printSetFormCheckbox(settingsScript,PSTR("QB"),fastStart);
     printSetFormValue(settingsScript,PSTR("BP"),bootPreset);
 
     printSetFormCheckbox(settingsScript,PSTR("GB"),gammaCorrectBri);
@@ -445,6 +446,7 @@ void getSettingsJS(byte subPage, Print& settingsScript)
     printSetFormCheckbox(settingsScript,PSTR("SB"),notifyButton);
     printSetFormCheckbox(settingsScript,PSTR("SH"),notifyHue);
     printSetFormValue(settingsScript,PSTR("UR"),udpNumRetries);
+    printSetFormValue(settingsScript,PSTR("UW"),notifyWindow);
 
     printSetFormCheckbox(settingsScript,PSTR("NL"),nodeListEnabled);
     printSetFormCheckbox(settingsScript,PSTR("NB"),nodeBroadcastEnabled);
@@ -456,6 +458,7 @@ void getSettingsJS(byte subPage, Print& settingsScript)
     printSetFormCheckbox(settingsScript,PSTR("ES"),e131SkipOutOfSequence);
     printSetFormCheckbox(settingsScript,PSTR("EM"),e131Multicast);
     printSetFormValue(settingsScript,PSTR("EU"),e131Universe);
+    printSetFormValue(settingsScript,PSTR("DJ"),ddpJitterMs);
 #ifdef WLED_ENABLE_DMX
     settingsScript.print(SET_F("hideNoDMX();"));  // hide "not compiled in" message
 #endif